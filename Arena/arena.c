@@ -0,0 +1,176 @@
+#include <string.h>
+#include "arena.h"
+
+size_t arena_block_size = ARENA_DEFAULT_BLOCK;
+THREAD_LOCAL Arena run_arena;
+
+// Block header rounded up so the first allocation is aligned
+#define BLOCK_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static char* block_data(ArenaBlock *b) {
+    return (char*)b + BLOCK_HEADER;
+}
+
+static size_t align_up(size_t size) {
+    if (size == 0) size = 1;
+    return (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+// --- Blocks ---
+
+static ArenaBlock* block_new(Arena *a, size_t min_size) {
+    size_t size = arena_block_size;
+    for (ArenaBlock *b = a->head; b != NULL; b = b->next) {
+        if (b->size * 2 > size) size = b->size * 2;
+    }
+    if (size < min_size) size = min_size;
+
+    ArenaBlock *b = (ArenaBlock*)malloc(BLOCK_HEADER + size);
+    if (b == NULL) {
+        printf("Out of memory (run arena at %zu bytes)\n", a->reserved);
+        exit(1);
+    }
+    b->next = NULL;
+    b->size = size;
+    b->used = 0;
+    a->reserved += size;
+    a->blocks++;
+    return b;
+}
+
+// --- Allocation ---
+
+void* arena_alloc(Arena *a, size_t size) {
+    size = align_up(size);
+
+    ArenaBlock *b = a->curr;
+    if (b == NULL) {
+        // First use, or first use after a rewind to an empty arena
+        b = a->head;
+        if (b != NULL) b->used = 0;
+    }
+    // Later blocks are free; one too small for this request is skipped
+    while (b != NULL && b->used + size > b->size) {
+        b = b->next;
+        if (b != NULL) b->used = 0;
+    }
+    if (b == NULL) {
+        b = block_new(a, size);
+        if (a->head == NULL) {
+            a->head = b;
+        } else {
+            ArenaBlock *tail = a->head;
+            while (tail->next != NULL) tail = tail->next;
+            tail->next = b;
+        }
+    }
+    a->curr = b;
+
+    void *ptr = block_data(b) + b->used;
+    b->used += size;
+    a->used += size;
+    if (a->used > a->peak) a->peak = a->used;
+    return ptr;
+}
+
+void* arena_calloc(Arena *a, size_t count, size_t size) {
+    void *ptr = arena_alloc(a, count * size);
+    memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* arena_grow(Arena *a, void *old, size_t old_size, size_t new_size) {
+    if (old == NULL) return arena_alloc(a, new_size);
+    ArenaBlock *b = a->curr;
+    size_t old_aligned = align_up(old_size);
+    size_t new_aligned = align_up(new_size);
+    if (b != NULL && (char*)old + old_aligned == block_data(b) + b->used &&
+        b->used - old_aligned + new_aligned <= b->size) {
+        b->used += new_aligned - old_aligned;
+        a->used += new_aligned - old_aligned;
+        if (a->used > a->peak) a->peak = a->used;
+        return old;
+    }
+    void *ptr = arena_alloc(a, new_size);
+    memcpy(ptr, old, old_size < new_size ? old_size : new_size);
+    return ptr;
+}
+
+// --- Marks ---
+
+ArenaMark arena_mark(const Arena *a) {
+    ArenaMark m;
+    m.block = a->curr;
+    m.block_used = (a->curr != NULL) ? a->curr->used : 0;
+    m.used = a->used;
+    return m;
+}
+
+void arena_rewind(Arena *a, ArenaMark m) {
+    a->curr = m.block;
+    if (m.block != NULL) m.block->used = m.block_used;
+    a->used = m.used;
+    a->epoch++;
+}
+
+void arena_release(Arena *a) {
+    ArenaBlock *b = a->head;
+    while (b != NULL) {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+    a->head = NULL;
+    a->curr = NULL;
+    a->used = 0;
+    a->reserved = 0;
+    a->blocks = 0;
+    a->epoch++;
+}
+
+// --- Pools ---
+
+void* pool_alloc(ArenaPool *pool, Arena *a, size_t size) {
+    if (pool->epoch != a->epoch) {
+        pool->free = NULL;
+        pool->epoch = a->epoch;
+    }
+    if (pool->free != NULL) {
+        void *obj = pool->free;
+        pool->free = *(void**)obj;
+        return obj;
+    }
+    return arena_alloc(a, size < sizeof(void*) ? sizeof(void*) : size);
+}
+
+void pool_free(ArenaPool *pool, Arena *a, void *obj) {
+    if (pool->epoch != a->epoch) {
+        pool->free = NULL;
+        pool->epoch = a->epoch;
+    }
+    *(void**)obj = pool->free;
+    pool->free = obj;
+}
+
+// --- Reporting ---
+
+static size_t merged_peak = 0;
+static size_t merged_reserved = 0;
+static int merged_blocks = 0;
+
+void arena_merge_peak(const Arena *a) {
+    if (a->peak > merged_peak) merged_peak = a->peak;
+    if (a->reserved > merged_reserved) {
+        merged_reserved = a->reserved;
+        merged_blocks = a->blocks;
+    }
+}
+
+void arena_report(void) {
+    arena_merge_peak(&run_arena);
+    printf("\nArena Peak                 = %.1f KB (%d block%s, %.1f KB reserved)\n",
+           merged_peak / 1024.0, merged_blocks, merged_blocks == 1 ? "" : "s", merged_reserved / 1024.0);
+    if (merged_blocks > 1) {
+        printf("Suggested --arena-size     = %zu KB\n", (merged_peak + 1023) / 1024);
+    }
+}
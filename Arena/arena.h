@@ -0,0 +1,76 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "common.h"
+
+// --- Run-Scoped Arena ---
+// Everything a simulation run allocates (task table, engine arrays, tree
+// nodes, per-class queues, sample buffers) comes from one bump allocator
+// per thread, run_arena. Nothing is freed one by one: a driver that runs
+// many simulations (tuner candidates, Monte Carlo replicas) takes a mark
+// before each run and rewinds to it afterwards, so the blocks stay mapped
+// and the next run reuses them without touching malloc.
+//
+// Blocks are chained. The first one is arena_block_size bytes (set with
+// --arena-size from a previous run's peak), each new one twice the last.
+// --arena-stats reports the peak, so the first block can be sized to hold
+// a whole run.
+
+#define ARENA_ALIGN 16
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;              // Usable bytes
+    size_t used;
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock *head;
+    ArenaBlock *curr;         // Block being carved; later ones are free
+    size_t used;              // Bytes handed out and not yet rewound
+    size_t peak;              // Largest 'used' seen
+    size_t reserved;          // Bytes held in blocks
+    int blocks;
+    long epoch;               // Bumped on every rewind (see ArenaPool)
+} Arena;
+
+typedef struct {
+    ArenaBlock *block;
+    size_t block_used;
+    size_t used;
+} ArenaMark;
+
+extern size_t arena_block_size;       // First block size, process-wide
+extern THREAD_LOCAL Arena run_arena;
+
+// ARENA_ALIGN-aligned, never NULL (exits if the system is out of memory)
+void* arena_alloc(Arena *a, size_t size);
+void* arena_calloc(Arena *a, size_t count, size_t size);
+// Resizes the newest allocation in place, otherwise copies; the old bytes
+// stay in the arena until the next rewind
+void* arena_grow(Arena *a, void *old, size_t old_size, size_t new_size);
+
+ArenaMark arena_mark(const Arena *a);
+void arena_rewind(Arena *a, ArenaMark m);   // Frees everything since the mark
+void arena_release(Arena *a);               // Returns the blocks to the system
+
+// --- Fixed-Size Recycling ---
+// Tree nodes come and go many times per run; a pool keeps the freed ones
+// for reuse. A rewind makes every pooled object invalid, so a pool whose
+// epoch is behind the arena's starts empty.
+typedef struct {
+    void *free;
+    long epoch;
+} ArenaPool;
+
+void* pool_alloc(ArenaPool *pool, Arena *a, size_t size);
+void pool_free(ArenaPool *pool, Arena *a, void *obj);
+
+// --- Peak Across Threads ---
+// Worker threads fold their arena's peak in before releasing it (under the
+// caller's lock); arena_report prints the largest of all threads.
+void arena_merge_peak(const Arena *a);
+void arena_report(void);
+
+#endif
@@ -1,22 +1,91 @@
 #include "cfs.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "Arena/arena.h"
 #include <stdio.h>
 #include <stdlib.h>
 
-// Linux Kernel Priority-to-Weight Mapping (Nice levels -20 to 19 approx)
-// We map User Priority 0-9 to indices in this array for simulation
-static const int prio_to_weight[] = {
-    88761, // Prio 0 (Highest weight)
-    29154, 
-    9548, 
-    3121, 
-    1024,  // Prio 4 (Base weight)
-    335, 
-    110, 
-    35, 
-    10, 
-    2      // Prio 9 (Lowest weight)
+// Linux Kernel Nice-to-Weight Mapping (nice -20 .. 19)
+// Each nice level is ~10% more/less CPU than its neighbour; nice 0 = 1024.
+static const int sched_prio_to_weight[40] = {
+ /* -20 */ 88761, 71755, 56483, 46273, 36291,
+ /* -15 */ 29154, 23254, 18705, 14949, 11916,
+ /* -10 */  9548,  7620,  6100,  4904,  3906,
+ /*  -5 */  3121,  2501,  1991,  1586,  1277,
+ /*   0 */  1024,   820,   655,   526,   423,
+ /*   5 */   335,   272,   215,   172,   137,
+ /*  10 */   110,    87,    70,    56,    45,
+ /*  15 */    36,    29,    23,    18,    15,
 };
 
+// Precomputed 2^32 / weight for the table above, so vruntime updates
+// multiply and shift instead of dividing.
+static const uint32_t sched_prio_to_wmult[40] = {
+ /* -20 */     48388,     59856,     76040,     92818,    118348,
+ /* -15 */    147320,    184698,    229616,    287308,    360437,
+ /* -10 */    449829,    563644,    704093,    875809,   1099582,
+ /*  -5 */   1376151,   1717300,   2157191,   2708050,   3363326,
+ /*   0 */   4194304,   5237765,   6557202,   8165337,  10153587,
+ /*   5 */  12820798,  15790321,  19976592,  24970740,  31350126,
+ /*  10 */  39045157,  49367440,  61356676,  76695844,  95443717,
+ /*  15 */ 119304647, 148102320, 186737708, 238609294, 286331153,
+};
+
+// User Priority 0-9 spread over the whole nice range, each level distinct:
+// 0 -> nice -20, 4 -> nice 0 (1024), 9 -> nice 19
+static const int prio_to_nice_table[10] = { -20, -15, -10, -5, 0, 3, 7, 11, 15, 19 };
+
+int prio_to_nice(int priority) {
+    if (priority < 0) priority = 0;
+    if (priority > 9) priority = 9;
+    return prio_to_nice_table[priority];
+}
+
+int prio_weight(int priority) {
+    return sched_prio_to_weight[prio_to_nice(priority) + 20];
+}
+
+void set_load_weight(Process *p) {
+    int nice = p->nice;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    p->weight = sched_prio_to_weight[nice + 20];
+    p->inv_weight = sched_prio_to_wmult[nice + 20];
+}
+
+void set_custom_weight(Process *p, long weight) {
+    if (weight < 2) weight = 2;
+    p->weight = weight;
+    p->inv_weight = (uint32_t)(WMULT_CONST / (uint64_t)weight);
+}
+
+// (a * mul) >> shift without a 128-bit intermediate
+static uint64_t mul_u64_u32_shr(uint64_t a, uint32_t mul, unsigned int shift) {
+    uint32_t ah = (uint32_t)(a >> 32);
+    uint32_t al = (uint32_t)a;
+    uint64_t ret = ((uint64_t)al * mul) >> shift;
+    if (ah) ret += ((uint64_t)ah * mul) << (32 - shift);
+    return ret;
+}
+
+// delta * BASE_WEIGHT / weight, computed as in the kernel's __calc_delta():
+// fold BASE_WEIGHT into the inverse weight, then keep the factor within
+// 32 bits by trading precision off the shift.
+uint64_t calc_delta_fair(uint64_t delta, const Process *p) {
+    if (p->weight == BASE_WEIGHT) return delta;
+
+    uint64_t fact = (uint64_t)BASE_WEIGHT * p->inv_weight;
+    int shift = WMULT_SHIFT;
+    while (fact >> 32) {
+        fact >>= 1;
+        shift--;
+    }
+    return mul_u64_u32_shr(delta, (uint32_t)fact, shift);
+}
+
+THREAD_LOCAL int sched_latency = SCHED_LATENCY;
+THREAD_LOCAL int sched_min_granularity = MIN_GRANULARITY;
+
 // --- AVL Tree Helper Functions ---
 
 int height(Node *N) {
@@ -28,8 +97,11 @@ int max_node(int a, int b) {
     return (a > b) ? a : b;
 }
 
+// Nodes come from the run arena; deleted ones are recycled
+static THREAD_LOCAL ArenaPool node_pool;
+
 Node* newNode(Process *p) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)pool_alloc(&node_pool, &run_arena, sizeof(Node));
     node->process = p;
     node->left = NULL;
     node->right = NULL;
@@ -66,44 +138,45 @@ int getBalance(Node *N) {
     return height(N->left) - height(N->right);
 }
 
+// Tree order: vruntime, then PID as tie-breaker
+bool entity_before(const Process *a, const Process *b) {
+    if (a->vruntime != b->vruntime) return a->vruntime < b->vruntime;
+    return a->pid < b->pid;
+}
+
 Node* insert(Node* node, Process *p) {
     if (node == NULL) return newNode(p);
 
-    // Standard BST Insert based on vruntime
-    if (p->vruntime < node->process->vruntime)
+    // Standard BST Insert based on vruntime (PID breaks ties so nodes stay unique)
+    if (entity_before(p, node->process))
         node->left = insert(node->left, p);
-    else if (p->vruntime > node->process->vruntime)
+    else
         node->right = insert(node->right, p);
-    else {
-        // Tie-breaker: Use PID to ensure unique nodes
-        if (p->pid < node->process->pid)
-            node->left = insert(node->left, p);
-        else
-            node->right = insert(node->right, p);
-    }
 
     // Update Height
     node->height = 1 + max_node(height(node->left), height(node->right));
 
     // Rebalance Tree
+    // (Cases must use the same ordering as the descent, or equal vruntimes
+    //  pick the wrong rotation.)
     int balance = getBalance(node);
 
     // Left Left Case
-    if (balance > 1 && p->vruntime < node->left->process->vruntime)
+    if (balance > 1 && entity_before(p, node->left->process))
         return rightRotate(node);
 
     // Right Right Case
-    if (balance < -1 && p->vruntime > node->right->process->vruntime)
+    if (balance < -1 && !entity_before(p, node->right->process))
         return leftRotate(node);
 
     // Left Right Case
-    if (balance > 1 && p->vruntime > node->left->process->vruntime) {
+    if (balance > 1 && !entity_before(p, node->left->process)) {
         node->left = leftRotate(node->left);
         return rightRotate(node);
     }
 
     // Right Left Case
-    if (balance < -1 && p->vruntime < node->right->process->vruntime) {
+    if (balance < -1 && entity_before(p, node->right->process)) {
         node->right = rightRotate(node->right);
         return leftRotate(node);
     }
@@ -142,7 +215,7 @@ Node* deleteNode(Node* root, Process *p) {
                     root = NULL;
                 } else
                     *root = *temp;
-                free(temp);
+                pool_free(&node_pool, &run_arena, temp);
             } else {
                 Node* temp = minValueNode(root->right);
                 root->process = temp->process;
@@ -172,140 +245,154 @@ Node* deleteNode(Node* root, Process *p) {
     return root;
 }
 
-// --- CFS Simulation Logic ---
+void freeTree(Node *node) {
+    if (node == NULL) return;
+    freeTree(node->left);
+    freeTree(node->right);
+    pool_free(&node_pool, &run_arena, node);
+}
 
-void run_cfs(Process p[], int n) {
-    printf("Starting Simulation (CFS with Red-Black/AVL Tree Logic)...\n");
-    reset_processes(p, n);
+// --- CFS Scheduling Class ---
 
+void cfs_init(CfsRq *rq, SimEngine *e) {
     // 1. Initialize Weights based on Priority
-    for(int i=0; i<n; i++) {
-        int safe_prio = p[i].priority;
-        if(safe_prio < 0) safe_prio = 0;
-        if(safe_prio > 9) safe_prio = 9;
-        
-        // Assign weight from lookup table
-        p[i].weight = prio_to_weight[safe_prio];
-        p[i].vruntime = 0;
+    for(int i=0; i<e->n; i++) {
+        // Assign weight and inverse weight from the nice tables
+        set_load_weight(&e->p[i]);
+        e->p[i].vruntime = 0;
     }
 
-    Node* root = NULL;
-    int current_time = 0;
-    int completed_count = 0;
-    
-    Process* current_process = NULL;
-    double current_slice_rem = 0; // Tracks remaining time slice for current process
-    double total_weight = 0;      // Sum of weights of all ready processes
-
-    // Gantt tracking variables
-    int gantt_start_time = 0;
-    int last_pid = -1;
-
-    while (completed_count < n) {
-        
-        // A. Handle New Arrivals
-        for (int i = 0; i < n; i++) {
-            if (p[i].at == current_time) {
-                // Determine initial vruntime:
-                // If tree is empty, vruntime = 0.
-                // If tree exists, set to min_vruntime to prevent starving existing tasks.
-                if (root != NULL) {
-                    Node* minNode = minValueNode(root);
-                    if (minNode) p[i].vruntime = minNode->process->vruntime;
-                } else if (current_process != NULL) {
-                    p[i].vruntime = current_process->vruntime;
-                }
-                
-                root = insert(root, &p[i]);
-                total_weight += p[i].weight;
-            }
-        }
+    rq->root = NULL;
+    rq->curr = NULL;
+    rq->total_weight = 0;  // Sum of weights of all ready processes
+    rq->slice_rem = 0;     // Tracks remaining time slice for current process
+}
 
-        // B. Select Process if CPU is idle
-        if (current_process == NULL && root != NULL) {
-            Node* minNode = minValueNode(root);
-            current_process = minNode->process;
-            root = deleteNode(root, current_process);
-            
-            // --- TIME SLICE CALCULATION ---
-            // Slice = Target_Latency * (Process_Weight / Total_Weight)
-            double slice = SCHED_LATENCY * (1.0 * current_process->weight / total_weight);
-            if (slice < MIN_GRANULARITY) slice = MIN_GRANULARITY;
-            
-            current_slice_rem = slice;
-            
-            // Track new Gantt segment start
-            gantt_start_time = current_time;
-            last_pid = current_process->pid;
-            
-            if (!current_process->started) {
-                current_process->start_time = current_time;
-                current_process->rt = current_time - current_process->at;
-                current_process->started = true;
-            }
-        }
+// Smallest vruntime among queued and running tasks
+static int64_t cfs_min_vruntime(CfsRq *rq, int64_t fallback) {
+    if (rq->root != NULL) return minValueNode(rq->root)->process->vruntime;
+    if (rq->curr != NULL) return rq->curr->vruntime;
+    return fallback;
+}
 
-        // C. Execute Current Process
-        if (current_process != NULL) {
-            // Run for 1 tick
-            current_process->rem_bt--;
-            current_slice_rem--; 
-            
-            // Update Virtual Runtime
-            // vruntime += delta * (BASE_WEIGHT / weight)
-            double delta = 1.0 * (1.0 * BASE_WEIGHT / current_process->weight);
-            current_process->vruntime += delta;
-            
-            // Log vruntime after update
-            add_vruntime_log(current_time, current_process->pid, current_process->vruntime);
-            
-            current_time++;
-
-            // D. Check Status
-            if (current_process->rem_bt == 0) {
-                // Process Completed
-                current_process->ct = current_time;
-                current_process->tat = current_process->ct - current_process->at;
-                current_process->wt = current_process->tat - current_process->bt;
-                current_process->completed = true;
-                
-                // Log final Gantt event for completed process
-                add_gantt_event(current_process->pid, gantt_start_time, current_time);
-                last_pid = -1; // Reset so we don't double-log
-                
-                total_weight -= current_process->weight; // Remove from load
-                completed_count++;
-                current_process = NULL;
-            } 
-            else if (current_slice_rem <= 0) {
-                // Time Slice Expired: Check for Preemption
-                if (root != NULL) {
-                    Node* minNode = minValueNode(root);
-                    // If the leftmost node has strictly less vruntime, switch.
-                    if (minNode->process->vruntime < current_process->vruntime) {
-                        // Log Gantt event for the previous run segment before context switch
-                        if (last_pid != -1 && gantt_start_time < current_time) {
-                            add_gantt_event(last_pid, gantt_start_time, current_time);
-                        }
-                        
-                        root = insert(root, current_process);
-                        current_process = NULL; // Trigger selection in next loop
-                    } else {
-                        // Keep running (renew slice simply by letting loop continue)
-                        // In real CFS, we would recalculate slice, here we give it 
-                        // MIN_GRANULARITY to avoid infinite loops if weights are weird
-                         current_slice_rem = MIN_GRANULARITY;
-                    }
-                } else {
-                    // No one else waiting, keep running
-                    current_slice_rem = SCHED_LATENCY;
-                }
-            }
-        } else {
-            // CPU is idle
-            current_time++;
-        }
+void cfs_enqueue(CfsRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)e;
+    if (flags == ENQUEUE_ARRIVAL) {
+        // Determine initial vruntime:
+        // If nothing else is runnable, vruntime = 0.
+        // Otherwise set to min_vruntime to prevent starving existing tasks.
+        x->vruntime = cfs_min_vruntime(rq, x->vruntime);
+    } else {
+        // Sleeper placement: keep the vruntime earned while sleeping, but
+        // credit at most half a latency period so long sleepers can't
+        // monopolize the CPU on return.
+        int64_t floor_vruntime = cfs_min_vruntime(rq, x->vruntime) - sched_latency * VRUNTIME_SCALE / 2;
+        if (x->vruntime < floor_vruntime) x->vruntime = floor_vruntime;
     }
 
+    rq->root = insert(rq->root, x);
+    rq->total_weight += x->weight;
+}
+
+// Arrivals wait for the running slice to expire
+static bool cfs_check_preempt(CfsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return false;
+}
+
+// The running task goes back into the tree
+void cfs_put_prev(CfsRq *rq) {
+    if (rq->curr == NULL) return;
+    rq->root = insert(rq->root, rq->curr);
+    rq->curr = NULL;
+}
+
+Process* cfs_pick_next(CfsRq *rq, SimEngine *e) {
+    (void)e;
+    cfs_put_prev(rq);
+    if (rq->root == NULL) return NULL;
+
+    rq->curr = minValueNode(rq->root)->process;
+    rq->root = deleteNode(rq->root, rq->curr);
+    return rq->curr;
+}
+
+void cfs_set_next(CfsRq *rq, SimEngine *e, Process *x) {
+    (void)e;
+    // --- TIME SLICE CALCULATION ---
+    // Slice = Target_Latency * (Process_Weight / Total_Weight)
+    double slice = sched_latency * (1.0 * x->weight / rq->total_weight);
+    if (slice < sched_min_granularity) slice = sched_min_granularity;
+
+    rq->slice_rem = slice;
+}
+
+// Run for 1 tick
+static int cfs_run_length(CfsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return 1;
+}
+
+int cfs_tick(CfsRq *rq, SimEngine *e, Process *x, int ran) {
+    (void)ran;
+    rq->slice_rem--;
+
+    // Update Virtual Runtime
+    // vruntime += delta * (BASE_WEIGHT / weight), in fixed point
+    x->vruntime += calc_delta_fair(VRUNTIME_SCALE, x);
+
+    // Log vruntime after update
+    add_vruntime_log(e->now, x->pid, x->vruntime);
+
+    if (rq->slice_rem > 0) return TICK_CONTINUE;
+
+    // Time Slice Expired: Check for Preemption
+    if (rq->root != NULL) {
+        // If the leftmost node has strictly less vruntime, switch.
+        if (minValueNode(rq->root)->process->vruntime < x->vruntime) return TICK_RESCHED;
+
+        // Keep running. In real CFS, we would recalculate slice, here we give
+        // it the minimum granularity to avoid infinite loops if weights are weird
+        rq->slice_rem = sched_min_granularity;
+    } else {
+        // No one else waiting, keep running
+        rq->slice_rem = sched_latency;
+    }
+    return TICK_CONTINUE;
+}
+
+// Exit or sleep: remove from load until the I/O completes
+void cfs_dequeue(CfsRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)e; (void)flags;
+    rq->total_weight -= x->weight;
+    rq->curr = NULL;
+}
+
+#define SCHED_CLASS cfs
+#define SCHED_RQ CfsRq
+#include "Engine/engine_loop.h"
+
+void cfs_run_init(CfsRun *r, Process p[], int n) {
+    engine_init(&r->e, p, n);
+    cfs_init(&r->rq, &r->e);
+}
+
+void cfs_run_step(CfsRun *r) {
+    cfs_engine_step(&r->e, &r->rq);
+}
+
+void cfs_run_free(CfsRun *r) {
+    freeTree(r->rq.root); // Non-empty only if the run was stopped early
+    r->rq.root = NULL;
+}
+
+void run_cfs(Process p[], int n) {
+    if (!sim_quiet) printf("Starting Simulation (CFS with Red-Black/AVL Tree Logic)...\n");
+
+    CfsRun run;
+    engine_init(&run.e, p, n);
+    cfs_engine_run(&run.e, &run.rq);
+    cfs_run_free(&run);
+
     print_table(p, n, "CFS (Fair Scheduling)");
 }
@@ -2,12 +2,29 @@
 #define CFS_H
 
 #include "common.h"
+#include "Engine/engine.h"
 
 // Constants for CFS Logic
 #define BASE_WEIGHT 1024
 #define SCHED_LATENCY 6      // Target Latency (e.g., 6ms/ticks)
 #define MIN_GRANULARITY 1    // Minimum time a task must run
 
+// Runtime tunables, default to the constants above (per thread, see Tune/)
+extern THREAD_LOCAL int sched_latency;
+extern THREAD_LOCAL int sched_min_granularity;
+
+#define WMULT_SHIFT 32
+#define WMULT_CONST (1ULL << WMULT_SHIFT)
+
+// --- Load Weights (kernel nice table, all 40 levels) ---
+int prio_to_nice(int priority);               // User priority 0-9 -> nice -20,-15,-10,-5,0,3,7,11,15,19
+int prio_weight(int priority);                // Weight for a user priority
+void set_load_weight(Process *p);             // weight/inv_weight from p->nice
+void set_custom_weight(Process *p, long weight); // Arbitrary weight (e.g. cpu.shares)
+
+// Weighted runtime: delta * BASE_WEIGHT / p->weight via multiply + shift
+uint64_t calc_delta_fair(uint64_t delta, const Process *p);
+
 // --- AVL Tree Definitions ---
 typedef struct Node {
     Process *process;
@@ -25,11 +42,87 @@ Node *leftRotate(Node *x);
 int getBalance(Node *N);
 
 // Core CFS Operations
+bool entity_before(const Process *a, const Process *b); // Tree order: vruntime, then PID
 Node* insert(Node* node, Process *p);
 Node *minValueNode(Node* node);
 Node* deleteNode(Node* root, Process *p);
+void freeTree(Node *node);
+
+// --- Scheduling Class State ---
+// The engine (Engine/engine.h) owns clocks, arrivals and the running task;
+// CFS keeps the ready tree and the slice of the running task.
+typedef struct {
+    Node *root;                // Ready tree (running task excluded)
+    Process *curr;             // Running task, NULL = none or another class runs
+    long total_weight;         // Weight of ready + running tasks
+    double slice_rem;          // Left of the running task's slice
+} CfsRq;
+
+// --- Stepwise Simulation State ---
+// The what-if replayer (cfs_whatif.c) drives a run one engine step at a
+// time and snapshots/restores it between steps.
+typedef struct {
+    SimEngine e;
+    CfsRq rq;
+} CfsRun;
+
+void cfs_run_init(CfsRun *r, Process p[], int n);
+void cfs_run_step(CfsRun *r); // Arrivals, wakeups, dispatch, then one tick
+void cfs_run_free(CfsRun *r);
+
+// Class operations (see Engine/engine.h), for classes stacked on CFS (RT/)
+void cfs_init(CfsRq *rq, SimEngine *e);
+void cfs_enqueue(CfsRq *rq, SimEngine *e, Process *x, int flags);
+void cfs_put_prev(CfsRq *rq);                  // Requeue rq->curr, e.g. when preempted by RT
+Process* cfs_pick_next(CfsRq *rq, SimEngine *e);
+void cfs_set_next(CfsRq *rq, SimEngine *e, Process *x);
+int cfs_tick(CfsRq *rq, SimEngine *e, Process *x, int ran);
+void cfs_dequeue(CfsRq *rq, SimEngine *e, Process *x, int flags);
 
 // Simulation Entry Point
 void run_cfs(Process p[], int n);
 
+// --- Checkpointed What-If Re-Simulation (cfs_whatif.c) ---
+// The baseline run snapshots its state every 'interval' ticks. Each
+// scenario then changes one task parameter, restores the latest checkpoint
+// taken before the change can have any effect and re-simulates only the
+// remaining suffix.
+#define WHATIF_DEFAULT_INTERVAL 50
+
+typedef enum { WHATIF_NICE, WHATIF_ARRIVAL } WhatIfField;
+
+typedef struct {
+    int pid;
+    WhatIfField field;
+    int value;
+    int time;   // WHATIF_NICE: tick at which the new nice takes effect
+} WhatIfChange;
+
+void run_cfs_whatif(Process p[], int n, int interval, WhatIfChange changes[], int k);
+
+// --- Hierarchical Group Scheduling (cfs_group.c) ---
+// Each TaskGroup owns a runqueue (AVL tree) of child entities: tasks and
+// nested groups. A group is represented in its parent's runqueue by 'se',
+// a Process used purely as a scheduling entity (pid = -id, weight = shares,
+// my_q = the group). Picking the next task walks down from the root,
+// taking the leftmost entity at each level: O(depth x log n).
+typedef struct TaskGroup {
+    int id;                   // 0 = root group
+    int shares;               // cpu.shares style weight (1024 = default)
+    struct TaskGroup *parent; // NULL for the root group
+
+    Process se;               // Entity queued in the parent's runqueue
+    Node *root;               // Runqueue of queued child entities
+    Process *curr;            // Child entity currently running (not in the tree)
+    long total_weight;        // Weight of queued + running children
+    int64_t min_vruntime;     // Monotonic floor for placing new entities
+    int nr_running;           // Queued + running children
+
+    int nr_tasks;             // Tasks placed directly in this group
+    long cpu_time;            // Ticks consumed by all tasks below this group
+} TaskGroup;
+
+// groups[0] must be the root group; tasks select theirs via Process.group
+void run_cfs_group(Process p[], int n, TaskGroup groups[], int g);
+
 #endif
@@ -0,0 +1,246 @@
+#include "cfs.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// --- Per-Group Runqueue Helpers ---
+
+// Smallest vruntime among the running and queued children of a group
+static void update_min_vruntime(TaskGroup *grp) {
+    int64_t vr = grp->min_vruntime;
+    bool found = false;
+
+    if (grp->curr != NULL) {
+        vr = grp->curr->vruntime;
+        found = true;
+    }
+    if (grp->root != NULL) {
+        int64_t left = minValueNode(grp->root)->process->vruntime;
+        if (!found || left < vr) vr = left;
+        found = true;
+    }
+
+    // min_vruntime only moves forward
+    if (found && vr > grp->min_vruntime) grp->min_vruntime = vr;
+}
+
+static void enqueue_entity(TaskGroup *grp, Process *se, bool wakeup) {
+    update_min_vruntime(grp);
+
+    if (wakeup) {
+        // Sleeper placement: credit at most half a latency period
+        int64_t floor_vruntime = grp->min_vruntime - sched_latency * VRUNTIME_SCALE / 2;
+        if (se->vruntime < floor_vruntime) se->vruntime = floor_vruntime;
+    } else {
+        // New task: start level with the group's current minimum
+        se->vruntime = grp->min_vruntime;
+    }
+
+    grp->root = insert(grp->root, se);
+    grp->total_weight += se->weight;
+    grp->nr_running++;
+
+    // First runnable child: the group itself becomes runnable in its parent
+    if (grp->nr_running == 1 && grp->parent != NULL) {
+        enqueue_entity(grp->parent, &grp->se, true);
+    }
+}
+
+static void dequeue_entity(TaskGroup *grp, Process *se) {
+    if (grp->curr == se) {
+        grp->curr = NULL;
+    } else {
+        grp->root = deleteNode(grp->root, se);
+    }
+    grp->total_weight -= se->weight;
+    grp->nr_running--;
+
+    // Last child gone: remove the group from its parent
+    if (grp->nr_running == 0 && grp->parent != NULL) {
+        dequeue_entity(grp->parent, &grp->se);
+    }
+}
+
+// Walk down from the root group taking the leftmost entity at every level
+static Process* pick_next_task(TaskGroup *top) {
+    TaskGroup *grp = top;
+    while (grp != NULL && grp->root != NULL) {
+        Process *se = minValueNode(grp->root)->process;
+        grp->root = deleteNode(grp->root, se);
+        grp->curr = se;
+        if (se->my_q == NULL) return se;
+        grp = se->my_q;
+    }
+    return NULL;
+}
+
+// Put the running entity back into its tree at every level of the hierarchy
+static void put_prev_task(Process *task) {
+    Process *se = task;
+    while (se != NULL && se->group != NULL) {
+        TaskGroup *grp = se->group;
+        if (grp->curr == se) {
+            grp->curr = NULL;
+            grp->root = insert(grp->root, se);
+        }
+        se = (grp->parent != NULL) ? &grp->se : NULL;
+    }
+}
+
+// Slice = latency scaled by the entity's share at every level
+static double task_slice(Process *task) {
+    double slice = sched_latency;
+    Process *se = task;
+    while (se != NULL && se->group != NULL) {
+        TaskGroup *grp = se->group;
+        slice *= (double)se->weight / grp->total_weight;
+        se = (grp->parent != NULL) ? &grp->se : NULL;
+    }
+    if (slice < sched_min_granularity) slice = sched_min_granularity;
+    return slice;
+}
+
+// Hierarchical accounting: every entity on the path ages by its own weight
+static void account_tick(Process *task) {
+    Process *se = task;
+    while (se != NULL && se->group != NULL) {
+        TaskGroup *grp = se->group;
+        se->vruntime += calc_delta_fair(VRUNTIME_SCALE, se);
+        grp->cpu_time++;
+        update_min_vruntime(grp);
+        se = (grp->parent != NULL) ? &grp->se : NULL;
+    }
+}
+
+// At any level, a queued sibling with strictly smaller vruntime wins the CPU
+static bool should_preempt(Process *task) {
+    Process *se = task;
+    while (se != NULL && se->group != NULL) {
+        TaskGroup *grp = se->group;
+        if (grp->root != NULL && minValueNode(grp->root)->process->vruntime < se->vruntime) {
+            return true;
+        }
+        se = (grp->parent != NULL) ? &grp->se : NULL;
+    }
+    return false;
+}
+
+static void print_group_table(TaskGroup groups[], int g) {
+    long total = groups[0].cpu_time;
+    if (total <= 0) total = 1;
+
+    printf("\n--- Group CPU Shares ---\n\n");
+    printf("Group\tParent\tShares\tTasks\tCPU\tShare%%\tOfParent%%\n");
+    for (int i = 0; i < g; i++) {
+        long parent_time = (groups[i].parent != NULL) ? groups[i].parent->cpu_time : groups[i].cpu_time;
+        if (parent_time <= 0) parent_time = 1;
+        printf("%d\t%d\t%d\t%d\t%ld\t%.2f\t%.2f\n",
+               groups[i].id,
+               (groups[i].parent != NULL) ? groups[i].parent->id : -1,
+               groups[i].shares,
+               groups[i].nr_tasks,
+               groups[i].cpu_time,
+               100.0 * groups[i].cpu_time / total,
+               100.0 * groups[i].cpu_time / parent_time);
+    }
+}
+
+// --- Group-Aware CFS Scheduling Class ---
+
+typedef struct {
+    TaskGroup *groups;
+    int g;
+    double slice_rem;
+} GroupRq;
+
+static void cfs_group_init(GroupRq *rq, SimEngine *e) {
+    Process *p = e->p;
+    TaskGroup *groups = rq->groups;
+
+    // 1. Reset group runqueues; group entities weigh their shares
+    for (int i = 0; i < rq->g; i++) {
+        TaskGroup *grp = &groups[i];
+        grp->root = NULL;
+        grp->curr = NULL;
+        grp->total_weight = 0;
+        grp->min_vruntime = 0;
+        grp->nr_running = 0;
+        grp->nr_tasks = 0;
+        grp->cpu_time = 0;
+
+        grp->se.pid = -grp->id; // Unique tie-breaker, never clashes with tasks
+        grp->se.vruntime = 0;
+        set_custom_weight(&grp->se, (grp->shares > 0) ? grp->shares : BASE_WEIGHT);
+        grp->se.group = grp->parent;
+        grp->se.my_q = grp;
+    }
+
+    for (int i = 0; i < e->n; i++) {
+        if (p[i].group == NULL) p[i].group = &groups[0];
+        set_load_weight(&p[i]);
+        p[i].vruntime = 0;
+        p[i].group->nr_tasks++;
+    }
+    rq->slice_rem = 0;
+}
+
+static void cfs_group_enqueue(GroupRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e;
+    enqueue_entity(x->group, x, flags == ENQUEUE_WAKEUP);
+}
+
+// Arrivals wait for the running slice to expire
+static bool cfs_group_check_preempt(GroupRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return false;
+}
+
+static Process* cfs_group_pick_next(GroupRq *rq, SimEngine *e) {
+    if (e->curr != NULL) put_prev_task(e->curr);
+    return pick_next_task(&rq->groups[0]);
+}
+
+static void cfs_group_set_next(GroupRq *rq, SimEngine *e, Process *x) {
+    (void)e;
+    rq->slice_rem = task_slice(x);
+}
+
+static int cfs_group_run_length(GroupRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return 1;
+}
+
+static int cfs_group_tick(GroupRq *rq, SimEngine *e, Process *x, int ran) {
+    (void)ran;
+    rq->slice_rem--;
+    account_tick(x);
+    add_vruntime_log(e->now, x->pid, x->vruntime);
+
+    if (rq->slice_rem > 0) return TICK_CONTINUE;
+    if (should_preempt(x)) return TICK_RESCHED;
+    rq->slice_rem = sched_min_granularity;
+    return TICK_CONTINUE;
+}
+
+static void cfs_group_dequeue(GroupRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)flags;
+    dequeue_entity(x->group, x);
+    put_prev_task(x); // Requeue still-runnable ancestors
+}
+
+#define SCHED_CLASS cfs_group
+#define SCHED_RQ GroupRq
+#include "Engine/engine_loop.h"
+
+void run_cfs_group(Process p[], int n, TaskGroup groups[], int g) {
+    printf("Starting Simulation (CFS with Hierarchical Group Scheduling, %d groups)...\n", g);
+
+    SimEngine e;
+    GroupRq rq;
+    rq.groups = groups;
+    rq.g = g;
+    engine_init(&e, p, n);
+    cfs_group_engine_run(&e, &rq);
+
+    print_table(p, n, "CFS (Group Scheduling)");
+    print_group_table(groups, g);
+}
@@ -0,0 +1,329 @@
+#include "cfs.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "Trace/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Checkpoints ---
+// Only the per-task fields a run mutates are saved; the workload itself
+// (bt, bursts, deadlines, ...) never changes and is shared with the live table.
+typedef struct {
+    int at;                 // Saved because arrival scenarios rewrite it
+    int nice;
+    long weight;
+    uint32_t inv_weight;
+    int64_t vruntime;
+    int rem_bt, start_time, ct, wt, tat, rt;
+    bool started, completed;
+
+    int burst_idx, next_block_at, ready_since;
+    bool blocked, wake_pending;
+    int wakeups, sched_lat_max;
+    long sched_lat_total;
+    int last_ran;
+} TaskSnapshot;
+
+typedef struct {
+    CfsRun run;             // Engine and runqueue; the tree and engine arrays are not owned
+    TaskSnapshot *tasks;
+    int *tree;              // Ready tree in preorder: task index per slot, -1 = empty
+    int *heights;           // AVL height per slot, so the exact shape comes back
+    SleepEntry *sleepers;
+    int sleeper_count;
+    CsState cs;
+    int gantt_cursor;       // Log entries written so far
+    VRuntimeCursor vruntime_cursor;
+} Checkpoint;
+
+static void save_tree(Node *node, Process p[], Checkpoint *c, int *pos) {
+    if (node == NULL) {
+        c->tree[*pos] = -1;
+        c->heights[*pos] = 0;
+        (*pos)++;
+        return;
+    }
+    c->tree[*pos] = (int)(node->process - p);
+    c->heights[*pos] = node->height;
+    (*pos)++;
+    save_tree(node->left, p, c, pos);
+    save_tree(node->right, p, c, pos);
+}
+
+static Node* load_tree(Process p[], const Checkpoint *c, int *pos) {
+    int idx = c->tree[*pos];
+    int h = c->heights[*pos];
+    (*pos)++;
+    if (idx < 0) return NULL;
+
+    Node *node = newNode(&p[idx]);
+    node->height = h;
+    node->left = load_tree(p, c, pos);
+    node->right = load_tree(p, c, pos);
+    return node;
+}
+
+static void save_checkpoint(Checkpoint *c, const CfsRun *r) {
+    Process *p = r->e.p;
+    int n = r->e.n;
+
+    c->run = *r;
+    c->run.rq.root = NULL;
+
+    c->tasks = (TaskSnapshot*)malloc(n * sizeof(TaskSnapshot));
+    for (int i = 0; i < n; i++) {
+        TaskSnapshot *t = &c->tasks[i];
+        t->at = p[i].at;
+        t->nice = p[i].nice;
+        t->weight = p[i].weight;
+        t->inv_weight = p[i].inv_weight;
+        t->vruntime = p[i].vruntime;
+        t->rem_bt = p[i].rem_bt;
+        t->start_time = p[i].start_time;
+        t->ct = p[i].ct;
+        t->wt = p[i].wt;
+        t->tat = p[i].tat;
+        t->rt = p[i].rt;
+        t->started = p[i].started;
+        t->completed = p[i].completed;
+        t->burst_idx = p[i].burst_idx;
+        t->next_block_at = p[i].next_block_at;
+        t->ready_since = p[i].ready_since;
+        t->blocked = p[i].blocked;
+        t->wake_pending = p[i].wake_pending;
+        t->wakeups = p[i].wakeups;
+        t->sched_lat_max = p[i].sched_lat_max;
+        t->sched_lat_total = p[i].sched_lat_total;
+        t->last_ran = p[i].last_ran;
+    }
+
+    // A tree of k nodes serializes to 2k + 1 slots, and k <= n
+    c->tree = (int*)malloc((2 * n + 1) * sizeof(int));
+    c->heights = (int*)malloc((2 * n + 1) * sizeof(int));
+    int pos = 0;
+    save_tree(r->rq.root, p, c, &pos);
+
+    c->sleeper_count = sleepq_save(&c->sleepers);
+    cs_save(&c->cs);
+    c->gantt_cursor = gantt_log_count;
+    vruntime_log_save(&c->vruntime_cursor);
+}
+
+static void restore_checkpoint(const Checkpoint *c, CfsRun *r) {
+    Process *p = r->e.p;
+    int n = r->e.n;
+
+    freeTree(r->rq.root);
+    *r = c->run;
+    int pos = 0;
+    r->rq.root = load_tree(p, c, &pos);
+
+    for (int i = 0; i < n; i++) {
+        const TaskSnapshot *t = &c->tasks[i];
+        p[i].at = t->at;
+        p[i].nice = t->nice;
+        p[i].weight = t->weight;
+        p[i].inv_weight = t->inv_weight;
+        p[i].vruntime = t->vruntime;
+        p[i].rem_bt = t->rem_bt;
+        p[i].start_time = t->start_time;
+        p[i].ct = t->ct;
+        p[i].wt = t->wt;
+        p[i].tat = t->tat;
+        p[i].rt = t->rt;
+        p[i].started = t->started;
+        p[i].completed = t->completed;
+        p[i].burst_idx = t->burst_idx;
+        p[i].next_block_at = t->next_block_at;
+        p[i].ready_since = t->ready_since;
+        p[i].blocked = t->blocked;
+        p[i].wake_pending = t->wake_pending;
+        p[i].wakeups = t->wakeups;
+        p[i].sched_lat_max = t->sched_lat_max;
+        p[i].sched_lat_total = t->sched_lat_total;
+        p[i].last_ran = t->last_ran;
+    }
+
+    // Arrival order may differ from the run that used it last
+    engine_sort_arrivals(&r->e);
+
+    sleepq_restore(c->sleepers, c->sleeper_count);
+    cs_restore(&c->cs);
+    gantt_log_count = c->gantt_cursor;
+    vruntime_log_restore(&c->vruntime_cursor);
+}
+
+static void free_checkpoint(Checkpoint *c) {
+    free(c->tasks);
+    free(c->tree);
+    free(c->heights);
+    free(c->sleepers);
+}
+
+// --- Scenario Helpers ---
+
+// Reweighting only changes future vruntime growth; the tree key stays valid
+static void apply_nice(CfsRun *r, Process *t, int nice) {
+    long old_weight = t->weight;
+    t->nice = nice;
+    set_load_weight(t);
+
+    // Queued and running tasks are part of the load
+    if (t->at <= r->e.admitted_until && !t->completed && !t->blocked) {
+        r->rq.total_weight += t->weight - old_weight;
+    }
+}
+
+typedef struct {
+    char change[32];
+    int resume_at;
+    int resimulated;
+    double avg_wt;
+    double avg_tat;
+    double avg_rt;
+    int end_time;
+} ScenarioResult;
+
+static void summarize(Process p[], int n, ScenarioResult *s) {
+    long wt = 0, tat = 0, rt = 0;
+    int end = 0;
+    for (int i = 0; i < n; i++) {
+        wt += p[i].wt;
+        tat += p[i].tat;
+        rt += p[i].rt;
+        if (p[i].ct > end) end = p[i].ct;
+    }
+    s->avg_wt = (double)wt / n;
+    s->avg_tat = (double)tat / n;
+    s->avg_rt = (double)rt / n;
+    s->end_time = end;
+}
+
+// --- What-If Simulation ---
+
+void run_cfs_whatif(Process p[], int n, int interval, WhatIfChange changes[], int k) {
+    printf("Starting Simulation (CFS with checkpoints every %d ticks, %d what-if scenarios)...\n",
+           interval, k);
+    if (interval < 1) interval = 1;
+
+    // 1. Baseline run, snapshotting at the top of the first iteration of
+    //    every interval (time may jump past a boundary during overhead)
+    CfsRun run;
+    cfs_run_init(&run, p, n);
+
+    Checkpoint *cps = NULL;
+    int cp_count = 0;
+    int cp_capacity = 0;
+    int next_checkpoint = 0;
+
+    while (run.e.completed < n) {
+        if (run.e.now >= next_checkpoint) {
+            if (cp_count == cp_capacity) {
+                cp_capacity = cp_capacity ? cp_capacity * 2 : 16;
+                cps = (Checkpoint*)realloc(cps, cp_capacity * sizeof(Checkpoint));
+            }
+            save_checkpoint(&cps[cp_count++], &run);
+            while (next_checkpoint <= run.e.now) next_checkpoint += interval;
+        }
+        cfs_run_step(&run);
+    }
+
+    print_table(p, n, "CFS (Fair Scheduling)");
+
+    Process *baseline = (Process*)malloc(n * sizeof(Process));
+    memcpy(baseline, p, n * sizeof(Process));
+
+    ScenarioResult *results = (ScenarioResult*)malloc((k + 1) * sizeof(ScenarioResult));
+    snprintf(results[0].change, sizeof(results[0].change), "baseline");
+    results[0].resume_at = 0;
+    results[0].resimulated = run.e.now;
+    summarize(p, n, &results[0]);
+    long resim_total = 0;
+
+    // 2. Scenarios: resume from the last checkpoint before the change matters.
+    //    Only the baseline goes to the trace and the progress stream.
+    trace_pause(true);
+    progress_pause(true);
+    for (int s = 0; s < k; s++) {
+        WhatIfChange *c = &changes[s];
+        ScenarioResult *res = &results[s + 1];
+
+        int idx = -1;
+        for (int i = 0; i < n; i++) {
+            if (baseline[i].pid == c->pid) idx = i;
+        }
+
+        if (c->field == WHATIF_NICE) {
+            snprintf(res->change, sizeof(res->change), "P%d nice=%d@%d", c->pid, c->value, c->time);
+        } else {
+            snprintf(res->change, sizeof(res->change), "P%d arrival=%d", c->pid, c->value);
+        }
+        if (idx < 0) {
+            printf("What-if %d: no process with PID %d, skipped\n", s + 1, c->pid);
+            res->resume_at = -1;
+            res->resimulated = 0;
+            summarize(baseline, n, res);
+            continue;
+        }
+
+        // An arrival change is first visible at the earlier of the two times
+        int diverge = c->time;
+        if (c->field == WHATIF_ARRIVAL) {
+            diverge = (c->value < baseline[idx].at) ? c->value : baseline[idx].at;
+        }
+
+        int cp = 0;
+        while (cp + 1 < cp_count && cps[cp + 1].run.e.now <= diverge) cp++;
+        restore_checkpoint(&cps[cp], &run);
+        res->resume_at = run.e.now;
+
+        bool applied = false;
+        if (c->field == WHATIF_ARRIVAL) {
+            p[idx].at = (c->value < 0) ? 0 : c->value;
+            p[idx].ready_since = p[idx].at;
+            engine_sort_arrivals(&run.e);
+            applied = true;
+        }
+
+        while (run.e.completed < n) {
+            if (!applied && run.e.now >= c->time) {
+                apply_nice(&run, &p[idx], c->value);
+                applied = true;
+            }
+            cfs_run_step(&run);
+        }
+
+        res->resimulated = run.e.now - res->resume_at;
+        resim_total += res->resimulated;
+        summarize(p, n, res);
+    }
+
+    trace_pause(false);
+    progress_pause(false);
+
+    // 3. Report
+    printf("\n--- What-If Scenarios ---\n\n");
+    printf("Scenario\tChange\tResume\tResim\tAvgWT\tAvgTAT\tAvgRT\tEnd\n");
+    for (int s = 0; s <= k; s++) {
+        printf("%d\t%s\t%d\t%d\t%.2f\t%.2f\t%.2f\t%d\n",
+               s, results[s].change, results[s].resume_at, results[s].resimulated,
+               results[s].avg_wt, results[s].avg_tat, results[s].avg_rt, results[s].end_time);
+    }
+
+    long full_total = (long)k * results[0].resimulated;
+    printf("\n");
+    printf("Checkpoints Taken          = %d (every %d ticks)\n", cp_count, interval);
+    printf("Ticks Re-Simulated         = %ld of %ld (%.2f%%)\n",
+           resim_total, full_total,
+           (full_total > 0) ? 100.0 * resim_total / full_total : 0.0);
+
+    // Leave the baseline results in place for the caller
+    memcpy(p, baseline, n * sizeof(Process));
+
+    cfs_run_free(&run);
+    for (int i = 0; i < cp_count; i++) free_checkpoint(&cps[i]);
+    free(cps);
+    free(results);
+    free(baseline);
+}
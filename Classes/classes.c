@@ -0,0 +1,337 @@
+#include <math.h>
+#include <string.h>
+#include "classes.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "Arena/arena.h"
+
+// --- Groups ---
+
+// Members are tasks first_id .. first_id + count - 1, numbered in the
+// order the equivalent regular input would list them
+typedef struct ClassGroup {
+    struct ClassGroup *next;
+    int cls;
+    int at;
+    int rem;                  // Remaining burst, the same for every member
+    long count;
+    long first_id;
+    bool started;
+} ClassGroup;
+
+// FIFO of groups (FCFS ready queue, RR sweeps)
+typedef struct {
+    ClassGroup *head;
+    ClassGroup *tail;
+} GroupQueue;
+
+static void queue_push(GroupQueue *q, ClassGroup *g) {
+    g->next = NULL;
+    if (q->tail != NULL) q->tail->next = g;
+    else q->head = g;
+    q->tail = g;
+}
+
+static ClassGroup* queue_pop(GroupQueue *q) {
+    ClassGroup *g = q->head;
+    q->head = g->next;
+    if (q->head == NULL) q->tail = NULL;
+    return g;
+}
+
+// --- Run State ---
+
+typedef struct {
+    long done;
+    double wt, tat, rt;
+    int max_wt, max_rt;
+    long arrivals;
+} ClassStats;
+
+typedef struct {
+    const TaskClass *classes;
+    int class_count;
+
+    // Arrival generators: each class's next arrival and tasks still to come
+    int next_at[MAX_TASK_CLASSES];
+    long left[MAX_TASK_CLASSES];
+    long next_id;
+
+    int now;
+    long last_task;           // Last task dispatched, -1 = none yet
+
+    ClassStats stats[MAX_TASK_CLASSES];
+    long completed;
+    double total_wt, total_tat, total_rt;
+    double total_burst;
+    int max_wt, max_rt;
+    int min_at, max_ct;
+    double fair_sum, fair_sq; // Jain's index terms, see calculate_jain_fairness
+
+    ArenaPool pool;
+    long groups;
+    long peak_groups;
+    long dispatches;          // Group dispatches: the simulation's steps
+} ClassRun;
+
+// Class whose next arrival comes first (ties: lower class, as in the
+// regular input), -1 once every class has arrived
+static int source_next(const ClassRun *r) {
+    int best = -1;
+    for (int c = 0; c < r->class_count; c++) {
+        if (r->left[c] == 0) continue;
+        if (best == -1 || r->next_at[c] < r->next_at[best]) best = c;
+    }
+    return best;
+}
+
+static bool arrived(const ClassRun *r) {
+    int c = source_next(r);
+    return c != -1 && r->next_at[c] <= r->now;
+}
+
+// Turns the next arrival into a group
+static ClassGroup* admit(ClassRun *r) {
+    int c = source_next(r);
+    const TaskClass *tc = &r->classes[c];
+    long count = (tc->gap > 0 && tc->per_arrival < r->left[c]) ? tc->per_arrival : r->left[c];
+
+    ClassGroup *g = (ClassGroup*)pool_alloc(&r->pool, &run_arena, sizeof(ClassGroup));
+    g->cls = c;
+    g->at = r->next_at[c];
+    g->rem = tc->bt;
+    g->count = count;
+    g->first_id = r->next_id;
+    g->started = false;
+
+    r->next_id += count;
+    r->left[c] -= count;
+    r->next_at[c] += tc->gap;
+    r->stats[c].arrivals++;
+    if (++r->groups > r->peak_groups) r->peak_groups = r->groups;
+    return g;
+}
+
+// --- Fairness Sums ---
+// Jain's index needs the sum of every task's allocation bt / tat and of its
+// square. A group's turnaround times form the series a + i * s, so both sums
+// are differences of the digamma function and its derivative, evaluated in
+// O(1). Small groups are summed directly, which is exact.
+
+#define FAIR_DIRECT_MAX 32
+
+// psi(x), x > 0: recurrence up to x >= 10, then the asymptotic series
+static double digamma(double x) {
+    double r = 0;
+    while (x < 10) { r -= 1 / x; x += 1; }
+    double f = 1 / (x * x);
+    return r + log(x) - 0.5 / x
+           - f * (1.0 / 12 - f * (1.0 / 120 - f * (1.0 / 252 - f * (1.0 / 240 - f / 132))));
+}
+
+// psi'(x), x > 0, the same way
+static double trigamma(double x) {
+    double r = 0;
+    while (x < 10) { r += 1 / (x * x); x += 1; }
+    double f = 1 / (x * x);
+    return r + 1 / x + f / 2 + f / x * (1.0 / 6 - f * (1.0 / 30 - f * (1.0 / 42 - f / 30)));
+}
+
+// Adds bt / (a + i * s) and its square for i = 0 .. k - 1 (a, s > 0)
+static void add_fairness(ClassRun *r, double bt, double a, double s, long k) {
+    if (k <= FAIR_DIRECT_MAX) {
+        for (long i = 0; i < k; i++) {
+            double allocation = bt / (a + i * s);
+            r->fair_sum += allocation;
+            r->fair_sq += allocation * allocation;
+        }
+        return;
+    }
+    double x = a / s;
+    r->fair_sum += bt / s * (digamma(x + k) - digamma(x));
+    r->fair_sq += (bt / s) * (bt / s) * (trigamma(x) - trigamma(x + k));
+}
+
+// --- Group Dispatch ---
+
+// Every member runs 'run' ticks, back to back: member i starts at
+// start0 + i * step. Response and completion sums are arithmetic series.
+static void run_group(ClassRun *r, ClassGroup *g, int run) {
+    const TaskClass *tc = &r->classes[g->cls];
+    ClassStats *st = &r->stats[g->cls];
+    long k = g->count;
+
+    // A lone task running again right after itself is not a switch
+    bool first_free = (r->last_task < 0 || r->last_task == g->first_id);
+    cs_charge_switches(k - 1 + (first_free ? 0 : 1));
+    int step = cs_switch_cost + run;
+    int start0 = r->now + (first_free ? 0 : cs_switch_cost);
+    int start_last = start0 + (int)(k - 1) * step;
+    double start_sum = (double)k * start0 + (double)step * k * (k - 1) / 2;
+
+    if (!g->started) {
+        double rt = start_sum - (double)k * g->at;
+        st->rt += rt;
+        r->total_rt += rt;
+        if (start_last - g->at > st->max_rt) st->max_rt = start_last - g->at;
+        if (start_last - g->at > r->max_rt) r->max_rt = start_last - g->at;
+        g->started = true;
+    }
+
+    g->rem -= run;
+    r->now = start_last + run;
+    r->last_task = g->first_id + k - 1;
+    r->dispatches++;
+    if (g->rem > 0) return;
+
+    // Completed: member i finishes at start0 + i * step + run
+    double tat = start_sum + (double)k * (run - g->at);
+    double wt = tat - (double)k * tc->bt;
+    int max_wt = r->now - g->at - tc->bt;
+    st->done += k;
+    st->tat += tat;
+    st->wt += wt;
+    if (max_wt > st->max_wt) st->max_wt = max_wt;
+
+    r->completed += k;
+    r->total_tat += tat;
+    r->total_wt += wt;
+    r->total_burst += (double)k * tc->bt;
+    if (max_wt > r->max_wt) r->max_wt = max_wt;
+    if (r->now > r->max_ct) r->max_ct = r->now;
+    add_fairness(r, tc->bt, (double)start0 + run - g->at, step, k);
+
+    pool_free(&r->pool, &run_arena, g);
+    r->groups--;
+}
+
+// --- Schedulers ---
+// The same loops as Stream/stream.c, over groups instead of processes
+
+static void classes_fcfs(ClassRun *r) {
+    GroupQueue ready = { NULL, NULL };
+
+    while (source_next(r) != -1 || ready.head != NULL) {
+        while (arrived(r)) queue_push(&ready, admit(r));
+        if (ready.head == NULL) {
+            r->now = r->next_at[source_next(r)]; // CPU idle until the next arrival
+            continue;
+        }
+
+        ClassGroup *g = queue_pop(&ready);
+        run_group(r, g, g->rem);
+    }
+}
+
+// Survivors of a sweep line up for the next one; arrivals join at the end
+// of the current sweep. All members of a group survive together.
+static void classes_rr(ClassRun *r, int tq) {
+    GroupQueue sweep = { NULL, NULL };
+    GroupQueue next_sweep = { NULL, NULL };
+    if (source_next(r) != -1) r->now = r->next_at[source_next(r)];
+
+    while (source_next(r) != -1 || sweep.head != NULL) {
+        bool worked = false;
+        while (1) {
+            ClassGroup *g;
+            if (sweep.head != NULL) g = queue_pop(&sweep);
+            else if (arrived(r)) g = admit(r);
+            else break;
+            worked = true;
+
+            bool done = g->rem <= tq;
+            run_group(r, g, done ? g->rem : tq);
+            if (!done) queue_push(&next_sweep, g);
+        }
+
+        GroupQueue t = sweep;
+        sweep = next_sweep;
+        next_sweep = t;
+        if (!worked && source_next(r) != -1) r->now = r->next_at[source_next(r)];
+    }
+}
+
+// --- Report ---
+
+static void print_classes(const ClassRun *r) {
+    printf("\n--- Task Classes ---\n\n");
+    printf("Class\tTasks\tBT\tArrivals\tAvg WT\tAvg TAT\tAvg RT\tMax WT\tMax RT\n");
+    for (int c = 0; c < r->class_count; c++) {
+        const ClassStats *st = &r->stats[c];
+        long n = st->done;
+        printf("%d\t%ld\t%d\t%ld\t%.2f\t%.2f\t%.2f\t%d\t%d\n", c + 1, n, r->classes[c].bt, st->arrivals,
+               n ? st->wt / n : 0.0, n ? st->tat / n : 0.0, n ? st->rt / n : 0.0, st->max_wt, st->max_rt);
+    }
+}
+
+static void print_summary(const ClassRun *r, const char *algo_name) {
+    long n = r->completed;
+    double total_time = r->max_ct - r->min_at;
+    if (total_time <= 0) total_time = 1;
+    long total_overhead = cs_switch_overhead + cs_cache_overhead;
+
+    printf("\n");
+    printf("Average Waiting Time       = %.2f\n", n ? r->total_wt / n : 0.0);
+    printf("Average Turnaround Time    = %.2f\n", n ? r->total_tat / n : 0.0);
+    printf("Average Response Time      = %.2f\n", n ? r->total_rt / n : 0.0);
+    printf("Max Waiting Time           = %d\n", r->max_wt);
+    printf("Max Response Time          = %d\n", r->max_rt);
+    printf("CPU Utilization            = %.2f%%\n", (r->total_burst + total_overhead) / total_time * 100.0);
+    printf("Effective CPU Utilization  = %.2f%%\n", r->total_burst / total_time * 100.0);
+    printf("Context Switches           = %ld\n", cs_switch_count);
+    printf("Switch Overhead            = %ld (switch %ld + cache %ld)\n",
+           total_overhead, cs_switch_overhead, cs_cache_overhead);
+    printf("Throughput                 = %.2f processes/unit time\n", n / total_time);
+    printf("Jain Fairness Index        = %.4f\n",
+           (r->fair_sq > 0) ? (r->fair_sum * r->fair_sum) / (n * r->fair_sq) : 0.0);
+    printf("\n--- %s Task Classes ---\n\n", algo_name);
+    printf("Tasks Simulated            = %ld\n", n);
+    printf("Group Dispatches           = %ld\n", r->dispatches);
+    printf("Peak Ready Groups          = %ld\n", r->peak_groups);
+    printf("Group Memory               = %zu bytes\n", (size_t)r->peak_groups * sizeof(ClassGroup));
+    printf("Expanded Task Table        = %zu bytes\n", (size_t)n * sizeof(Process));
+}
+
+// --- Entry Point ---
+
+bool run_classes(int algo, const TaskClass classes[], int class_count, int time_quantum) {
+    const char *algo_name;
+    switch (algo) {
+        case 1: algo_name = "FCFS Scheduling"; break;
+        case 4: algo_name = "Round Robin"; break;
+        default:
+            printf("Task-class mode supports FCFS and RR only.\n");
+            return false;
+    }
+    if (io_enabled || cs_cache_penalty > 0) {
+        printf("Task-class mode does not support I/O phases or the cache model.\n");
+        return false;
+    }
+    if (time_quantum < 1) time_quantum = 1;
+
+    ClassRun r;
+    memset(&r, 0, sizeof(r));
+    r.classes = classes;
+    r.class_count = (class_count < MAX_TASK_CLASSES) ? class_count : MAX_TASK_CLASSES;
+    r.last_task = -1;
+    long total = 0;
+    for (int c = 0; c < r.class_count; c++) {
+        r.next_at[c] = classes[c].first_at;
+        r.left[c] = classes[c].count;
+        total += classes[c].count;
+    }
+    int first = source_next(&r);
+    r.min_at = (first != -1) ? r.next_at[first] : 0;
+    cs_reset();
+
+    printf("Starting Simulation (%s, %d task classes, %ld tasks)...\n", algo_name, r.class_count, total);
+
+    ArenaMark mark = arena_mark(&run_arena);
+    if (algo == 1) classes_fcfs(&r);
+    else classes_rr(&r, time_quantum);
+    arena_rewind(&run_arena, mark);
+
+    print_classes(&r);
+    print_summary(&r, algo_name);
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef CLASSES_H
+#define CLASSES_H
+
+#include "common.h"
+
+// --- Task-Class Workloads ---
+// A workload of many identical tasks described by class instead of task
+// by task: each class has a task count, a burst and an arrival generator.
+// Arrivals come every 'gap' ticks from 'first_at', 'per_arrival' tasks at a
+// time ('gap' 0 = all at once); the last arrival may bring fewer.
+//
+// Tasks of one class that arrive at the same tick are never materialized:
+// they stay one ClassGroup (class, arrival, remaining burst, count) for
+// the whole run. Under FCFS and RR every member of a group is dispatched
+// back to back and has the same remaining burst, so a group is never
+// split, and its members' start and completion times are an arithmetic
+// series; a group is simulated in O(1) and metrics are summed in closed
+// form. Memory and work follow the number of arrival batches in the
+// system, not the number of tasks.
+//
+// The equivalent regular input lists the tasks by (arrival, class, member)
+// and gives the same results. Supported: FCFS (1) and RR (4) with
+// --cs-cost; not I/O phases or the cache model (per-task warmth would
+// tell group members apart).
+
+#define MAX_TASK_CLASSES 64
+
+typedef struct {
+    long count;
+    int bt;
+    int first_at;
+    int gap;                  // Ticks between arrivals, 0 = all at once
+    long per_arrival;         // Tasks per arrival
+} TaskClass;
+
+// Returns false on an unsupported algorithm or option
+bool run_classes(int algo, const TaskClass classes[], int class_count, int time_quantum);
+
+#endif
@@ -0,0 +1,82 @@
+#include <math.h>
+#include "ctxswitch.h"
+
+int cs_switch_cost = 0;
+int cs_cache_penalty = 0;
+int cs_cache_decay = 0;
+
+THREAD_LOCAL long cs_switch_count = 0;
+THREAD_LOCAL long cs_switch_overhead = 0;
+THREAD_LOCAL long cs_cache_overhead = 0;
+
+// Task whose working set is currently in the cache
+static THREAD_LOCAL Process *cs_last = NULL;
+
+// Stands in for a retired task that was the last to run
+static THREAD_LOCAL Process cs_exited;
+
+void cs_reset(void) {
+    cs_last = NULL;
+    cs_switch_count = 0;
+    cs_switch_overhead = 0;
+    cs_cache_overhead = 0;
+}
+
+int cs_dispatch(Process *p, int now) {
+    if (p == cs_last) return 0;
+
+    int overhead = 0;
+
+    // Direct cost: only a switch if something else was running before
+    if (cs_last != NULL) {
+        cs_last->last_ran = now;
+        cs_switch_count++;
+        overhead += cs_switch_cost;
+        cs_switch_overhead += cs_switch_cost;
+    }
+
+    // Cache refill: proportional to how much of p's footprint has decayed
+    if (cs_cache_penalty > 0) {
+        double cold = 1.0;
+        if (p->last_ran >= 0 && cs_cache_decay > 0) {
+            cold = 1.0 - exp(-(double)(now - p->last_ran) / cs_cache_decay);
+        }
+        int refill = (int)(cs_cache_penalty * cold + 0.5);
+        overhead += refill;
+        cs_cache_overhead += refill;
+    }
+
+    cs_last = p;
+    return overhead;
+}
+
+void cs_retire(Process *p) {
+    if (p == cs_last) cs_last = &cs_exited;
+}
+
+long cs_charge_switches(long switches) {
+    long overhead = switches * cs_switch_cost;
+    cs_switch_count += switches;
+    cs_switch_overhead += overhead;
+    return overhead;
+}
+
+Process* cs_swap_owner(Process *owner) {
+    Process *prev = cs_last;
+    cs_last = owner;
+    return prev;
+}
+
+void cs_save(CsState *s) {
+    s->last = cs_last;
+    s->switch_count = cs_switch_count;
+    s->switch_overhead = cs_switch_overhead;
+    s->cache_overhead = cs_cache_overhead;
+}
+
+void cs_restore(const CsState *s) {
+    cs_last = s->last;
+    cs_switch_count = s->switch_count;
+    cs_switch_overhead = s->switch_overhead;
+    cs_cache_overhead = s->cache_overhead;
+}
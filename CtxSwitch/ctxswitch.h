@@ -0,0 +1,55 @@
+#ifndef CTXSWITCH_H
+#define CTXSWITCH_H
+
+#include "common.h"
+
+// --- Context-Switch and Cache-Warmth Cost Model ---
+// Every time the CPU starts running a different task than the one it ran
+// last, the simulator charges:
+//   switch cost : fixed overhead for the switch itself
+//   cache cost  : refill time for the incoming task's working set. A task's
+//                 cache footprint decays while other tasks run, so
+//                 penalty = cache_penalty * (1 - e^(-away / cache_decay))
+//                 where 'away' is the time since it was last descheduled.
+//                 A task that never ran starts fully cold.
+// Overhead ticks keep the CPU busy without progressing any task.
+
+extern int cs_switch_cost;     // Ticks per context switch (default 0)
+extern int cs_cache_penalty;   // Ticks to refill a fully cold cache (default 0)
+extern int cs_cache_decay;     // Decay constant of cache warmth in ticks (0 = always cold)
+
+extern THREAD_LOCAL long cs_switch_count;
+extern THREAD_LOCAL long cs_switch_overhead; // Direct switch ticks charged
+extern THREAD_LOCAL long cs_cache_overhead;  // Cache refill ticks charged
+
+void cs_reset(void);
+
+// Called whenever a scheduler dispatches 'p' at time 'now'.
+// Returns the overhead (in ticks) to spend before 'p' makes progress.
+int cs_dispatch(Process *p, int now);
+
+// Called when 'p' leaves the simulation for good and its storage may be
+// reused (streaming mode): the next dispatch still counts as a switch.
+void cs_retire(Process *p);
+
+// Task-class mode (Classes/) dispatches whole groups of tasks that the
+// model does not track one by one: charges 'switches' direct switches and
+// returns their overhead. Only the switch cost applies.
+long cs_charge_switches(long switches);
+
+// Multi-CPU runs (SMP/) keep one cache owner per CPU and install it before
+// dispatching on that CPU. Returns the owner it replaces.
+Process* cs_swap_owner(Process *owner);
+
+// --- Checkpoint Support ---
+typedef struct {
+    Process *last; // Task whose working set is in the cache
+    long switch_count;
+    long switch_overhead;
+    long cache_overhead;
+} CsState;
+
+void cs_save(CsState *s);
+void cs_restore(const CsState *s);
+
+#endif
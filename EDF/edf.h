@@ -1,3 +1,16 @@
 #include "common.h"
 
 void run_edf(Process p[], int n);
+
+// --- EDF with a Constant Bandwidth Server (SCHED_DEADLINE) ---
+// Each task reserves dl_runtime ticks of CPU every period and is scheduled
+// by an absolute deadline that CBS assigns. A task that uses up its budget
+// is throttled until its next period instead of delaying everyone else; a
+// task waking with more budget than its bandwidth allows over the time left
+// gets a fresh deadline. Tasks are admitted at arrival only while the sum of
+// dl_runtime / period stays within the RT bandwidth limit (--rt-runtime /
+// --rt-period, as in the kernel); rejected tasks run in the background, FIFO
+// behind every reserved one.
+#define DL_BW_SHIFT 20   // Fixed point of bandwidths, as the kernel's BW_SHIFT
+
+void run_edf_cbs(Process p[], int n);
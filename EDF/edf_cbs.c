@@ -0,0 +1,307 @@
+#include "edf.h"
+#include "Engine/engine.h"
+#include "IO/io.h"
+#include "RT/rt.h"
+#include "Timer/timer_wheel.h"
+#include "Arena/arena.h"
+
+// --- Deadline Task State ---
+
+typedef struct {
+    long bw;              // runtime / period, DL_BW_SHIFT fixed point
+    bool admitted;        // false = rejected, runs in the background
+    int deadline;         // Absolute scheduling deadline
+    int budget;           // Runtime left before that deadline
+    bool throttled;       // Budget used up, waiting for its replenishment timer
+    int throttle_count;
+    int misses;           // Scheduling deadlines passed with budget left
+    int replenishments;
+    TimerNode replenish;  // Pending while throttled
+} CbsTask;
+
+// --- Binary Min-Heap of (key, task index) ---
+// Ready queue (keyed by deadline) and background queue (by ready_since),
+// O(log n) per operation. Replenishment timers sit in a timing wheel.
+
+typedef struct {
+    int key;
+    int idx;
+} CbsEntry;
+
+typedef struct {
+    CbsEntry *entries;
+    int count;
+} CbsHeap;
+
+static bool entry_before(CbsEntry a, CbsEntry b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.idx < b.idx;
+}
+
+static void heap_push(CbsHeap *h, int key, int idx) {
+    CbsEntry x = { key, idx };
+    int i = h->count++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!entry_before(x, h->entries[parent])) break;
+        h->entries[i] = h->entries[parent];
+        i = parent;
+    }
+    h->entries[i] = x;
+}
+
+static CbsEntry heap_pop(CbsHeap *h) {
+    CbsEntry top = h->entries[0];
+    CbsEntry last = h->entries[--h->count];
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= h->count) break;
+        if (child + 1 < h->count && entry_before(h->entries[child + 1], h->entries[child])) child++;
+        if (!entry_before(h->entries[child], last)) break;
+        h->entries[i] = h->entries[child];
+        i = child;
+    }
+    if (h->count > 0) h->entries[i] = last;
+    return top;
+}
+
+// --- CBS Scheduling Class ---
+
+typedef struct {
+    CbsTask *task;
+    CbsHeap ready;        // Admitted and runnable, by deadline
+    CbsHeap background;   // Rejected and runnable, by ready_since
+    TimerWheel timers;    // Throttled, by replenishment time
+    long total_bw;        // Bandwidth of admitted tasks still in the system
+    long max_bw;          // Admission limit, -1 = unlimited
+    long peak_bw;
+    int rejected;
+} CbsRq;
+
+static long to_ratio(long period, long runtime) {
+    return (runtime << DL_BW_SHIFT) / period;
+}
+
+static CbsTask* cbs_task(CbsRq *rq, SimEngine *e, Process *x) {
+    return &rq->task[x - e->p];
+}
+
+// New reservation period starting now
+static void cbs_refresh(CbsTask *t, const Process *x, int now) {
+    t->deadline = now + x->deadline;
+    t->budget = x->dl_runtime;
+}
+
+// Kernel replenish_dl_entity(): postpone the deadline one period per
+// exhausted budget; a deadline left in the past starts over from now
+static void cbs_replenish(CbsTask *t, const Process *x, int now) {
+    while (t->budget <= 0) {
+        t->deadline += x->period;
+        t->budget += x->dl_runtime;
+        t->replenishments++;
+    }
+    if (t->deadline < now) cbs_refresh(t, x, now);
+}
+
+static void cbs_throttle(CbsRq *rq, SimEngine *e, Process *x, int now) {
+    CbsTask *t = cbs_task(rq, e, x);
+    int next_period = t->deadline - x->deadline + x->period;
+    t->throttle_count++;
+    if (next_period <= now) {
+        cbs_replenish(t, x, now);
+        // The running task is requeued by pick_next; pushing it here too
+        // would leave a stale duplicate in the n-entry heap
+        if (x != e->curr) heap_push(&rq->ready, t->deadline, (int)(x - e->p));
+        return;
+    }
+    t->throttled = true;
+    tw_add(&rq->timers, &t->replenish, next_period);
+}
+
+static void cbs_queue(CbsRq *rq, SimEngine *e, Process *x) {
+    CbsTask *t = cbs_task(rq, e, x);
+    if (t->admitted) heap_push(&rq->ready, t->deadline, (int)(x - e->p));
+    else heap_push(&rq->background, x->ready_since, (int)(x - e->p));
+}
+
+static void cbs_init(CbsRq *rq, SimEngine *e) {
+    rq->task = (CbsTask*)arena_calloc(&run_arena, e->n, sizeof(CbsTask));
+    rq->ready.entries = (CbsEntry*)arena_alloc(&run_arena, e->n * sizeof(CbsEntry));
+    rq->background.entries = (CbsEntry*)arena_alloc(&run_arena, e->n * sizeof(CbsEntry));
+    rq->ready.count = rq->background.count = 0;
+    tw_init(&rq->timers, e->now);
+    rq->total_bw = 0;
+    rq->peak_bw = 0;
+    rq->rejected = 0;
+    // Same limit as the kernel: sched_rt_runtime_us / sched_rt_period_us
+    rq->max_bw = (rt_runtime < 0) ? -1 : to_ratio(rt_period, rt_runtime);
+
+    for (int i = 0; i < e->n; i++) {
+        e->p[i].abs_deadline = e->p[i].at + e->p[i].deadline;
+        rq->task[i].bw = to_ratio(e->p[i].period, e->p[i].dl_runtime);
+        tw_node_init(&rq->task[i].replenish, i);
+    }
+}
+
+static void cbs_enqueue(CbsRq *rq, SimEngine *e, Process *x, int flags) {
+    CbsTask *t = cbs_task(rq, e, x);
+    int now = e->now;
+
+    if (flags == ENQUEUE_ARRIVAL) {
+        // Admission control: the reservation must fit the remaining bandwidth
+        t->admitted = rq->max_bw < 0 || rq->total_bw + t->bw <= rq->max_bw;
+        if (t->admitted) {
+            rq->total_bw += t->bw;
+            if (rq->total_bw > rq->peak_bw) rq->peak_bw = rq->total_bw;
+            cbs_refresh(t, x, now);
+        } else {
+            rq->rejected++;
+        }
+    } else if (t->admitted) {
+        // Still throttled: the replenishment timer queues it
+        if (t->throttled) return;
+
+        // CBS wakeup rule: keep (deadline, budget) unless the deadline has
+        // passed or the leftover budget would exceed the reserved bandwidth
+        // over the time left, budget / (deadline - now) > runtime / period
+        if (t->deadline <= now ||
+            (long)t->budget * x->period > (long)(t->deadline - now) * x->dl_runtime) {
+            cbs_refresh(t, x, now);
+        } else if (t->budget <= 0) {
+            cbs_throttle(rq, e, x, now);
+            return;
+        }
+    }
+    cbs_queue(rq, e, x);
+}
+
+// Reserved tasks beat background ones, and earlier deadlines later ones
+static bool cbs_check_preempt(CbsRq *rq, SimEngine *e, Process *x) {
+    CbsTask *t = cbs_task(rq, e, x);
+    CbsTask *c = cbs_task(rq, e, e->curr);
+    if (!t->admitted || t->throttled) return false;
+    return !c->admitted || t->deadline < c->deadline;
+}
+
+// Due replenishment timers return throttled tasks to the ready queue
+static void cbs_fire_timers(CbsRq *rq, SimEngine *e) {
+    TimerNode *next;
+    for (TimerNode *n = tw_advance(&rq->timers, e->now); n != NULL; n = next) {
+        next = n->next;
+        Process *x = &e->p[n->owner];
+        CbsTask *t = cbs_task(rq, e, x);
+        t->throttled = false;
+        cbs_replenish(t, x, e->now);
+        if (!x->blocked) heap_push(&rq->ready, t->deadline, (int)(x - e->p)); // Else at wakeup
+    }
+}
+
+static Process* cbs_pick_next(CbsRq *rq, SimEngine *e) {
+    if (e->curr != NULL && !cbs_task(rq, e, e->curr)->throttled) cbs_queue(rq, e, e->curr);
+    cbs_fire_timers(rq, e);
+    e->timer = tw_next_expiry(&rq->timers);
+
+    // Deadlines that passed while waiting are misses; CBS starts them over
+    while (rq->ready.count > 0 && rq->ready.entries[0].key <= e->now) {
+        Process *x = &e->p[heap_pop(&rq->ready).idx];
+        CbsTask *t = cbs_task(rq, e, x);
+        t->misses++;
+        cbs_refresh(t, x, e->now);
+        heap_push(&rq->ready, t->deadline, (int)(x - e->p));
+    }
+
+    if (rq->ready.count > 0) return &e->p[heap_pop(&rq->ready).idx];
+    if (rq->background.count > 0) return &e->p[heap_pop(&rq->background).idx];
+    return NULL;
+}
+
+static void cbs_set_next(CbsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+}
+
+// Tick by tick, so budgets and timers are checked every tick
+static int cbs_run_length(CbsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return 1;
+}
+
+static int cbs_tick(CbsRq *rq, SimEngine *e, Process *x, int ran) {
+    CbsTask *t = cbs_task(rq, e, x);
+    int end = e->now + ran;
+
+    // A job that ends or blocks this tick needs no enforcement: the wakeup
+    // rule deals with what is left of its reservation
+    if (t->admitted && io_cpu_left(x) > 0) {
+        t->budget -= ran;
+        if (t->budget <= 0) {
+            cbs_throttle(rq, e, x, end);
+            return TICK_YIELD;
+        }
+        if (t->deadline <= end) {
+            t->misses++;
+            cbs_refresh(t, x, end);
+            return TICK_RESCHED;
+        }
+    }
+    int timer = tw_next_expiry(&rq->timers);
+    if (timer != -1 && timer <= end) return TICK_RESCHED;
+    return TICK_CONTINUE;
+}
+
+static void cbs_dequeue(CbsRq *rq, SimEngine *e, Process *x, int flags) {
+    CbsTask *t = cbs_task(rq, e, x);
+    // A sleeping task keeps its reservation, an exiting one returns it
+    if (flags == DEQUEUE_EXIT && t->admitted) rq->total_bw -= t->bw;
+}
+
+#define SCHED_CLASS cbs
+#define SCHED_RQ CbsRq
+#include "Engine/engine_loop.h"
+
+// --- Reporting ---
+
+static double bw_percent(long bw) {
+    return 100.0 * bw / (1L << DL_BW_SHIFT);
+}
+
+static void print_reservations(CbsRq *rq, Process p[], int n) {
+    long throttles = 0, misses = 0;
+
+    printf("\n--- Deadline Reservations ---\n\n");
+    printf("PID\tRuntime\tDeadline\tPeriod\tBW %%\tAdmitted\tThrottled\tMisses\tPeriods\n");
+    for (int i = 0; i < n; i++) {
+        CbsTask *t = &rq->task[i];
+        printf("%d\t%d\t%d\t%d\t%.2f\t%s\t%d\t%d\t%d\n", p[i].pid, p[i].dl_runtime, p[i].deadline,
+               p[i].period, bw_percent(t->bw), t->admitted ? "yes" : "no", t->throttle_count,
+               t->misses, t->replenishments);
+        throttles += t->throttle_count;
+        misses += t->misses;
+    }
+
+    printf("\n");
+    if (rq->max_bw < 0) {
+        printf("Admission Limit            = unlimited\n");
+    } else {
+        printf("Admission Limit            = %.2f%% (RT runtime %d of every %d ticks)\n",
+               bw_percent(rq->max_bw), rt_runtime, rt_period);
+    }
+    printf("Peak Admitted Bandwidth    = %.2f%%\n", bw_percent(rq->peak_bw));
+    printf("Rejected Tasks             = %d (run in the background)\n", rq->rejected);
+    printf("Throttle Events            = %ld\n", throttles);
+    printf("Deadline Misses            = %ld\n", misses);
+}
+
+// --- Simulation Entry Point ---
+
+void run_edf_cbs(Process p[], int n) {
+    printf("Starting Simulation (EDF with Constant Bandwidth Server)...\n");
+
+    SimEngine e;
+    CbsRq rq;
+    engine_init(&e, p, n);
+    cbs_engine_run(&e, &rq);
+
+    print_table(p, n, "EDF + CBS (SCHED_DEADLINE)");
+    print_reservations(&rq, p, n);
+}
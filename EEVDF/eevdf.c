@@ -0,0 +1,359 @@
+#include "eevdf.h"
+#include "CFS/cfs.h"
+#include "IO/io.h"
+#include "Engine/engine.h"
+#include "Arena/arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// --- Augmented AVL Tree Helpers ---
+
+static int eevdf_height(EevdfNode *N) {
+    return (N == NULL) ? 0 : N->height;
+}
+
+// Recompute height and subtree min deadline from the children
+static void eevdf_update(EevdfNode *N) {
+    int hl = eevdf_height(N->left);
+    int hr = eevdf_height(N->right);
+    N->height = ((hl > hr) ? hl : hr) + 1;
+
+    N->min_deadline = N->process->vdeadline;
+    if (N->left != NULL && N->left->min_deadline < N->min_deadline)
+        N->min_deadline = N->left->min_deadline;
+    if (N->right != NULL && N->right->min_deadline < N->min_deadline)
+        N->min_deadline = N->right->min_deadline;
+}
+
+// Nodes come from the run arena; deleted ones are recycled
+static THREAD_LOCAL ArenaPool node_pool;
+
+static EevdfNode* eevdf_new_node(Process *p) {
+    EevdfNode *node = (EevdfNode*)pool_alloc(&node_pool, &run_arena, sizeof(EevdfNode));
+    node->process = p;
+    node->left = NULL;
+    node->right = NULL;
+    eevdf_update(node);
+    return node;
+}
+
+static EevdfNode* eevdf_rotate_right(EevdfNode *y) {
+    EevdfNode *x = y->left;
+    y->left = x->right;
+    x->right = y;
+    eevdf_update(y);
+    eevdf_update(x);
+    return x;
+}
+
+static EevdfNode* eevdf_rotate_left(EevdfNode *x) {
+    EevdfNode *y = x->right;
+    x->right = y->left;
+    y->left = x;
+    eevdf_update(x);
+    eevdf_update(y);
+    return y;
+}
+
+static EevdfNode* eevdf_rebalance(EevdfNode *node) {
+    eevdf_update(node);
+    int balance = eevdf_height(node->left) - eevdf_height(node->right);
+
+    if (balance > 1) {
+        if (eevdf_height(node->left->left) < eevdf_height(node->left->right))
+            node->left = eevdf_rotate_left(node->left);
+        return eevdf_rotate_right(node);
+    }
+    if (balance < -1) {
+        if (eevdf_height(node->right->right) < eevdf_height(node->right->left))
+            node->right = eevdf_rotate_right(node->right);
+        return eevdf_rotate_left(node);
+    }
+    return node;
+}
+
+// Tree order: vruntime, then PID
+static bool eevdf_less(Process *a, Process *b) {
+    if (a->vruntime != b->vruntime) return a->vruntime < b->vruntime;
+    return a->pid < b->pid;
+}
+
+EevdfNode* eevdf_insert(EevdfNode *node, Process *p) {
+    if (node == NULL) return eevdf_new_node(p);
+
+    if (eevdf_less(p, node->process))
+        node->left = eevdf_insert(node->left, p);
+    else
+        node->right = eevdf_insert(node->right, p);
+
+    return eevdf_rebalance(node);
+}
+
+EevdfNode* eevdf_delete(EevdfNode *root, Process *p) {
+    if (root == NULL) return NULL;
+
+    if (p == root->process) {
+        if (root->left == NULL || root->right == NULL) {
+            EevdfNode *child = root->left ? root->left : root->right;
+            pool_free(&node_pool, &run_arena, root);
+            return child;
+        }
+        // Two children: replace with in-order successor
+        EevdfNode *succ = root->right;
+        while (succ->left != NULL) succ = succ->left;
+        root->process = succ->process;
+        root->right = eevdf_delete(root->right, succ->process);
+    } else if (eevdf_less(p, root->process)) {
+        root->left = eevdf_delete(root->left, p);
+    } else {
+        root->right = eevdf_delete(root->right, p);
+    }
+
+    return eevdf_rebalance(root);
+}
+
+// Walk the tree once: an eligible node makes its whole left subtree eligible
+// too (smaller vruntime), so that subtree's cached min_deadline is a candidate.
+// Ineligible nodes send the search left. Finally descend into the winning
+// subtree to find the node that owns the minimum deadline.
+Process* eevdf_pick(EevdfNode *root, int64_t avg_vruntime) {
+    Process *best = NULL;
+    EevdfNode *best_subtree = NULL;
+    int64_t best_deadline = 0;
+
+    EevdfNode *node = root;
+    while (node != NULL) {
+        if (node->process->vruntime > avg_vruntime) {
+            node = node->left;
+            continue;
+        }
+
+        if (best == NULL && best_subtree == NULL) {
+            best = node->process;
+            best_deadline = node->process->vdeadline;
+        } else if (node->process->vdeadline < best_deadline) {
+            best = node->process;
+            best_subtree = NULL;
+            best_deadline = node->process->vdeadline;
+        }
+        if (node->left != NULL && node->left->min_deadline < best_deadline) {
+            best = NULL;
+            best_subtree = node->left;
+            best_deadline = node->left->min_deadline;
+        }
+        node = node->right;
+    }
+
+    node = best_subtree;
+    while (node != NULL) {
+        if (node->process->vdeadline == best_deadline) return node->process;
+        if (node->left != NULL && node->left->min_deadline == best_deadline)
+            node = node->left;
+        else
+            node = node->right;
+    }
+    return best;
+}
+
+// --- Weighted Average Vruntime (the zero-lag point V) ---
+// Sums cover every runnable entity, including the one on the CPU. As in the
+// kernel, vruntimes enter the sum as keys relative to zero_vruntime so that
+// sum(w * key) stays well inside 64 bits; rebase() moves the reference.
+static THREAD_LOCAL int64_t zero_vruntime = 0;
+static THREAD_LOCAL long sum_weight = 0;
+static THREAD_LOCAL int64_t sum_weighted_key = 0;
+static THREAD_LOCAL int64_t last_avg_vruntime = 0;
+
+static int64_t avg_vruntime(void) {
+    if (sum_weight > 0) {
+        // Floor division keeps "v <= V" exact for negative sums
+        int64_t avg = sum_weighted_key;
+        if (avg < 0) avg -= sum_weight - 1;
+        last_avg_vruntime = zero_vruntime + avg / sum_weight;
+    }
+    return last_avg_vruntime;
+}
+
+static void avg_add(Process *p) {
+    sum_weight += p->weight;
+    sum_weighted_key += p->weight * (p->vruntime - zero_vruntime);
+}
+
+static void avg_sub(Process *p) {
+    sum_weight -= p->weight;
+    sum_weighted_key -= p->weight * (p->vruntime - zero_vruntime);
+}
+
+static void rebase(int64_t new_zero) {
+    sum_weighted_key -= sum_weight * (new_zero - zero_vruntime);
+    zero_vruntime = new_zero;
+}
+
+// Virtual length of one request
+static int64_t vslice(Process *p) {
+    return calc_delta_fair(EEVDF_BASE_SLICE * VRUNTIME_SCALE, p);
+}
+
+// Place a (re)joining entity so that it keeps its lag relative to V.
+// Joining shifts V itself, so the lag is inflated by (W + w) / W first.
+static void place_entity(Process *p) {
+    int64_t V = avg_vruntime();
+    int64_t lag = p->vlag;
+    if (sum_weight > 0) lag = lag * (sum_weight + p->weight) / sum_weight;
+
+    p->vruntime = V - lag;
+    p->vdeadline = p->vruntime + vslice(p);
+}
+
+// Remember the lag when leaving the runqueue, bounded to two requests
+static void save_lag(Process *p) {
+    int64_t limit = 2 * vslice(p);
+    int64_t lag = avg_vruntime() - p->vruntime;
+    if (lag > limit) lag = limit;
+    if (lag < -limit) lag = -limit;
+    p->vlag = lag;
+}
+
+// --- Sample Buffers for Distribution Reporting ---
+typedef struct {
+    double *values;
+    int count;
+    int capacity;
+} Samples;
+
+static void samples_add(Samples *s, double v) {
+    if (s->count == s->capacity) {
+        int old = s->capacity;
+        s->capacity = s->capacity ? s->capacity * 2 : 256;
+        s->values = (double*)arena_grow(&run_arena, s->values, old * sizeof(double),
+                                        s->capacity * sizeof(double));
+    }
+    s->values[s->count++] = v;
+}
+
+static void print_distribution(const char *label, Samples *s) {
+    if (s->count == 0) {
+        printf("%s\t0\t-\t-\t-\t-\t-\n", label);
+        return;
+    }
+    double sum = 0;
+    for (int i = 0; i < s->count; i++) sum += s->values[i];
+
+    double p50 = percentile(s->values, s->count, 50);
+    double p90 = percentile(s->values, s->count, 90);
+    double p99 = percentile(s->values, s->count, 99);
+    printf("%s\t%d\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n", label, s->count,
+           s->values[0], sum / s->count, p50, p90, p99, s->values[s->count - 1]);
+}
+
+// --- EEVDF Scheduling Class ---
+
+typedef struct {
+    EevdfNode *root;
+    int *queued_at;             // Time each process last joined the runqueue (arrival, wakeup, preemption)
+    Samples lag_samples;        // Lag (in ticks of service) of every picked task
+    Samples latency_samples;    // Runqueue wait before every dispatch
+} EevdfRq;
+
+static void eevdf_init(EevdfRq *rq, SimEngine *e) {
+    for (int i = 0; i < e->n; i++) {
+        set_load_weight(&e->p[i]);
+        e->p[i].vruntime = 0;
+        e->p[i].vlag = 0;
+    }
+
+    zero_vruntime = 0;
+    sum_weight = 0;
+    sum_weighted_key = 0;
+    last_avg_vruntime = 0;
+
+    rq->root = NULL;
+}
+
+static void eevdf_enqueue(EevdfRq *rq, SimEngine *e, Process *x, int flags) {
+    if (flags == ENQUEUE_ARRIVAL) x->vlag = 0; // New tasks start at V, wakeups restore saved lag
+    place_entity(x);
+    avg_add(x);
+    rq->root = eevdf_insert(rq->root, x);
+    rq->queued_at[x - e->p] = (flags == ENQUEUE_ARRIVAL) ? e->now : x->ready_since;
+}
+
+// Arrivals wait for the running request to be served
+static bool eevdf_check_preempt(EevdfRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return false;
+}
+
+// The eligible task with the earliest virtual deadline
+static Process* eevdf_pick_next(EevdfRq *rq, SimEngine *e) {
+    Process *prev = e->curr;
+    if (rq->root == NULL) return prev; // Nothing queued: keep running
+    if (prev != NULL) {
+        rq->root = eevdf_insert(rq->root, prev);
+        rq->queued_at[prev - e->p] = e->now;
+    }
+
+    int64_t V = avg_vruntime();
+    rebase(V);
+    Process *next = eevdf_pick(rq->root, V);
+    if (next == NULL) next = eevdf_pick(rq->root, INT64_MAX); // Never empty-handed
+    rq->root = eevdf_delete(rq->root, next);
+
+    // Lag in ticks of service owed to the picked task
+    samples_add(&rq->lag_samples, (double)(V - next->vruntime) * next->weight
+                                  / BASE_WEIGHT / VRUNTIME_SCALE);
+    return next;
+}
+
+static void eevdf_set_next(EevdfRq *rq, SimEngine *e, Process *x) {
+    samples_add(&rq->latency_samples, e->now - rq->queued_at[x - e->p]);
+}
+
+static int eevdf_run_length(EevdfRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return 1;
+}
+
+static int eevdf_tick(EevdfRq *rq, SimEngine *e, Process *x, int ran) {
+    (void)rq; (void)ran;
+    int64_t delta = calc_delta_fair(VRUNTIME_SCALE, x);
+    x->vruntime += delta;
+    sum_weighted_key += x->weight * delta;
+
+    add_vruntime_log(e->now, x->pid, x->vruntime);
+
+    if (io_cpu_left(x) > 0 && x->vruntime >= x->vdeadline) {
+        // Request served: issue the next one and let the tree decide
+        x->vdeadline = x->vruntime + vslice(x);
+        return TICK_RESCHED;
+    }
+    return TICK_CONTINUE;
+}
+
+static void eevdf_dequeue(EevdfRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)flags;
+    save_lag(x);
+    avg_sub(x);
+}
+
+#define SCHED_CLASS eevdf
+#define SCHED_RQ EevdfRq
+#include "Engine/engine_loop.h"
+
+void run_eevdf(Process p[], int n) {
+    if (!sim_quiet) printf("Starting Simulation (EEVDF with Augmented AVL Tree)...\n");
+
+    SimEngine e;
+    EevdfRq rq = {0};
+    rq.queued_at = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    engine_init(&e, p, n);
+    eevdf_engine_run(&e, &rq);
+
+    print_table(p, n, "EEVDF");
+    if (sim_quiet) return;
+
+    printf("\n--- EEVDF Lag / Latency Distribution ---\n\n");
+    printf("Metric\tSamples\tMin\tMean\tP50\tP90\tP99\tMax\n");
+    print_distribution("Lag", &rq.lag_samples);
+    print_distribution("Latency", &rq.latency_samples);
+}
@@ -0,0 +1,29 @@
+#ifndef EEVDF_H
+#define EEVDF_H
+
+#include "common.h"
+
+// Constants for EEVDF Logic (weights come from the CFS table)
+#define EEVDF_BASE_SLICE 3   // Requested slice per pick (ticks of real time)
+
+// --- Augmented AVL Tree ---
+// Ordered by vruntime; every node also caches the smallest virtual deadline
+// in its subtree so the earliest eligible deadline is found in O(log n).
+typedef struct EevdfNode {
+    Process *process;
+    struct EevdfNode *left;
+    struct EevdfNode *right;
+    int height;
+    int64_t min_deadline;
+} EevdfNode;
+
+EevdfNode* eevdf_insert(EevdfNode *node, Process *p);
+EevdfNode* eevdf_delete(EevdfNode *root, Process *p);
+
+// Eligible entity (vruntime <= avg_vruntime) with the earliest virtual deadline
+Process* eevdf_pick(EevdfNode *root, int64_t avg_vruntime);
+
+// Simulation Entry Point
+void run_eevdf(Process p[], int n);
+
+#endif
@@ -0,0 +1,106 @@
+#include <stdlib.h>
+#include "engine.h"
+#include "IO/io.h"
+#include "Arena/arena.h"
+
+// --- Arrival Order ---
+
+static THREAD_LOCAL const Process *sort_table;
+
+static int compare_arrival(const void *a, const void *b) {
+    int i = *(const int*)a;
+    int j = *(const int*)b;
+    if (sort_table[i].at != sort_table[j].at) return (sort_table[i].at < sort_table[j].at) ? -1 : 1;
+    return i - j;
+}
+
+void engine_sort_arrivals(SimEngine *e) {
+    for (int i = 0; i < e->n; i++) e->arrivals[i] = i;
+    sort_table = e->p;
+    qsort(e->arrivals, e->n, sizeof(int), compare_arrival);
+
+    e->next_arrival = 0;
+    while (e->next_arrival < e->n && e->p[e->arrivals[e->next_arrival]].at <= e->admitted_until) {
+        e->next_arrival++;
+    }
+}
+
+void engine_init(SimEngine *e, Process p[], int n) {
+    reset_processes(p, n);
+
+    e->p = p;
+    e->n = n;
+    e->now = 0;
+    e->completed = 0;
+    e->curr = NULL;
+    e->need_resched = false;
+    e->resched_reason = TRACE_END_RESCHED;
+    e->admitted_until = -1;
+    e->timer = -1;
+    e->gantt_pid = -1;
+    e->gantt_start = 0;
+
+    e->arrivals = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    e->batch = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    engine_sort_arrivals(e);
+}
+
+// --- Step Helpers ---
+
+// Everything that arrived since the previous step. Time can advance by more
+// than one tick (switch overhead, multi-tick runs), so a batch may span
+// several arrival times; it is enqueued in table order, as the per-tick
+// scans over p[] always did.
+int engine_admit(SimEngine *e) {
+    int count = 0;
+    while (e->next_arrival < e->n && e->p[e->arrivals[e->next_arrival]].at <= e->now) {
+        int idx = e->arrivals[e->next_arrival++];
+        int k = count++;
+        while (k > 0 && e->batch[k - 1] > idx) {
+            e->batch[k] = e->batch[k - 1];
+            k--;
+        }
+        e->batch[k] = idx;
+    }
+    e->admitted_until = e->now;
+    return count;
+}
+
+void engine_gantt_close(SimEngine *e, int reason) {
+    if (e->gantt_pid == -1) return;
+    add_gantt_event(e->gantt_pid, e->gantt_start, e->now);
+    trace_slice(0, e->gantt_pid, e->gantt_start, e->now, reason);
+    e->gantt_pid = -1;
+}
+
+void engine_dispatched(SimEngine *e, Process *x) {
+    if (e->gantt_pid == -1) {
+        e->gantt_pid = x->pid;
+        e->gantt_start = e->now;
+    }
+    if (!x->started) {
+        x->start_time = e->now;
+        x->rt = e->now - x->at;
+        x->started = true;
+    }
+    io_note_dispatch(x, e->now);
+}
+
+void engine_complete(SimEngine *e, Process *x) {
+    x->ct = e->now;
+    x->tat = x->ct - x->at;
+    x->wt = x->tat - x->bt - x->io_time;
+    x->completed = true;
+    e->completed++;
+    trace_lifetime(x);
+}
+
+void engine_idle(SimEngine *e) {
+    int next = io_next_wakeup();
+    if (e->next_arrival < e->n) {
+        int at = e->p[e->arrivals[e->next_arrival]].at;
+        if (next == -1 || at < next) next = at;
+    }
+    if (e->timer > e->now && (next == -1 || e->timer < next)) next = e->timer;
+    e->now = (next > e->now) ? next : e->now + 1;
+}
@@ -0,0 +1,88 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "common.h"
+#include "Trace/trace.h"
+
+// --- Simulation Engine ---
+// One loop drives every scheduler. A scheduling class (sched_class in the
+// kernel) supplies a runqueue type and the operations below, all named
+// <class>_<op> and defined static in the class's source file:
+//
+//   void     init(RQ *rq, SimEngine *e)
+//            Once, after the task table has been reset.
+//   void     enqueue(RQ *rq, SimEngine *e, Process *x, int flags)
+//            x became runnable: ENQUEUE_ARRIVAL or ENQUEUE_WAKEUP.
+//   bool     check_preempt(RQ *rq, SimEngine *e, Process *x)
+//            x was just enqueued while e->curr runs: reschedule now?
+//   Process* pick_next(RQ *rq, SimEngine *e)
+//            Task to run next, NULL = idle. If e->curr is set it is still
+//            runnable; the class requeues it if it keeps it in a queue.
+//            A class that must act at a set time even if nothing arrives
+//            (throttling, replenishment) stores it in e->timer.
+//   void     set_next(RQ *rq, SimEngine *e, Process *x)
+//            x was switched in (switch overhead already charged).
+//   int      run_length(RQ *rq, SimEngine *e, Process *x)
+//            Ticks x runs before the class is consulted again.
+//   int      tick(RQ *rq, SimEngine *e, Process *x, int ran)
+//            Account 'ran' ticks just executed (rem_bt already reduced,
+//            e->now still at their start). Returns a TICK_* action, which
+//            only applies if x is still runnable afterwards.
+//   void     dequeue(RQ *rq, SimEngine *e, Process *x, int flags)
+//            The running task left the CPU for good (DEQUEUE_EXIT) or
+//            blocked on I/O (DEQUEUE_SLEEP).
+//
+// Defining SCHED_CLASS and SCHED_RQ and including Engine/engine_loop.h then
+// generates <class>_engine_step() and <class>_engine_run(), which call the
+// operations directly. There are no function pointers on the hot path and
+// the compiler can inline each class into its own copy of the loop.
+//
+// The engine owns everything the schedulers used to duplicate: arrivals,
+// I/O wakeups, switch/cache overhead, response and completion accounting,
+// Gantt segments, idle skipping and early stop.
+
+#define ENQUEUE_ARRIVAL 0
+#define ENQUEUE_WAKEUP  1
+
+#define DEQUEUE_EXIT    0
+#define DEQUEUE_SLEEP   1
+
+#define TICK_CONTINUE   0   // Keep running
+#define TICK_RESCHED    1   // Pick again; the Gantt segment continues if x is re-picked
+#define TICK_YIELD      2   // Pick again and start a new Gantt segment
+
+typedef struct {
+    Process *p;
+    int n;
+    int now;
+    int completed;
+    Process *curr;          // Task on the CPU, NULL = idle
+    bool need_resched;
+    int resched_reason;     // TRACE_END_* of the slice a pending resched ends
+    int admitted_until;     // Arrivals up to this time have been enqueued
+    int timer;              // Class wake-up while idle (e.g. end of throttling), -1 = none
+
+    int gantt_pid;          // Open Gantt segment, -1 = none
+    int gantt_start;
+
+    int *arrivals;          // Task indices by (arrival time, index)
+    int next_arrival;       // First entry of 'arrivals' not yet admitted
+    int *batch;             // Scratch: arrivals admitted by one step
+} SimEngine;
+
+// Resets the task table and prepares the arrival order. The arrays come
+// from the run arena (Arena/) and go away with it.
+void engine_init(SimEngine *e, Process p[], int n);
+
+// Re-sorts arrivals after arrival times changed (what-if replays). Tasks
+// with at <= admitted_until must be exactly the ones already admitted.
+void engine_sort_arrivals(SimEngine *e);
+
+// --- Used by Engine/engine_loop.h ---
+int engine_admit(SimEngine *e);                 // Fills e->batch in table order, returns count
+void engine_dispatched(SimEngine *e, Process *x);
+void engine_complete(SimEngine *e, Process *x);
+void engine_gantt_close(SimEngine *e, int reason);  // reason: TRACE_END_*
+void engine_idle(SimEngine *e);                 // Skips to the next arrival, wakeup or timer
+
+#endif
@@ -0,0 +1,126 @@
+// Simulation loop template, specialized per scheduling class (see engine.h).
+// Include once per source file after defining:
+//   SCHED_CLASS  name prefix of the class operations, e.g. cfs
+//   SCHED_RQ     runqueue type passed to them, e.g. CfsRq
+// Optionally:
+//   SCHED_PER_TICK  the class re-picks every tick from a scan over the task
+//                   table and keeps no queue: only init and pick_next are
+//                   supplied, the other operations default to no-ops
+// Generates:
+//   static void <class>_engine_step(SimEngine *e, SCHED_RQ *rq)  one iteration
+//   static void <class>_engine_run(SimEngine *e, SCHED_RQ *rq)   init + loop to completion
+
+#if !defined(SCHED_CLASS) || !defined(SCHED_RQ)
+#error "Define SCHED_CLASS and SCHED_RQ before including Engine/engine_loop.h"
+#endif
+
+#include "engine.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+
+#define ENGINE_PASTE2(a, b) a##_##b
+#define ENGINE_PASTE(a, b) ENGINE_PASTE2(a, b)
+#define ENGINE_OP(op) ENGINE_PASTE(SCHED_CLASS, op)
+
+#ifdef SCHED_PER_TICK
+static inline void ENGINE_OP(enqueue)(SCHED_RQ *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)x; (void)flags;
+}
+static inline bool ENGINE_OP(check_preempt)(SCHED_RQ *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return false;
+}
+static inline void ENGINE_OP(set_next)(SCHED_RQ *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+}
+static inline int ENGINE_OP(run_length)(SCHED_RQ *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return 1;
+}
+static inline int ENGINE_OP(tick)(SCHED_RQ *rq, SimEngine *e, Process *x, int ran) {
+    (void)rq; (void)e; (void)x; (void)ran;
+    return TICK_RESCHED;
+}
+static inline void ENGINE_OP(dequeue)(SCHED_RQ *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)x; (void)flags;
+}
+#endif
+
+static void ENGINE_OP(engine_step)(SimEngine *e, SCHED_RQ *rq) {
+    Process *x;
+
+    // A. Arrivals, then I/O wakeups
+    int arrived = engine_admit(e);
+    for (int k = 0; k < arrived; k++) {
+        x = &e->p[e->batch[k]];
+        ENGINE_OP(enqueue)(rq, e, x, ENQUEUE_ARRIVAL);
+        if (e->curr != NULL && ENGINE_OP(check_preempt)(rq, e, x)) {
+            e->need_resched = true;
+            e->resched_reason = TRACE_END_PREEMPT;
+        }
+    }
+    while ((x = io_pop_wakeup(e->now)) != NULL) {
+        ENGINE_OP(enqueue)(rq, e, x, ENQUEUE_WAKEUP);
+        if (e->curr != NULL && ENGINE_OP(check_preempt)(rq, e, x)) {
+            e->need_resched = true;
+            e->resched_reason = TRACE_END_PREEMPT;
+        }
+    }
+
+    // B. Pick, and switch if the choice changed
+    if (e->curr == NULL || e->need_resched) {
+        Process *prev = e->curr;
+        Process *next = ENGINE_OP(pick_next)(rq, e);
+        e->need_resched = false;
+
+        if (next != prev) {
+            engine_gantt_close(e, e->resched_reason);
+            e->curr = next;
+            if (next != NULL) {
+                // Switch and cache-refill overhead: the CPU is busy but makes no progress
+                e->now += cs_dispatch(next, e->now);
+                ENGINE_OP(set_next)(rq, e, next);
+            }
+        }
+        if (next != NULL) engine_dispatched(e, next);
+    }
+
+    x = e->curr;
+    if (x == NULL) {
+        engine_idle(e);
+        return;
+    }
+
+    // C. Run
+    int ran = ENGINE_OP(run_length)(rq, e, x);
+    x->rem_bt -= ran;
+    int action = ENGINE_OP(tick)(rq, e, x, ran);
+    e->now += ran;
+
+    // D. Exit, sleep or carry on
+    if (x->rem_bt == 0) {
+        engine_complete(e, x);
+        engine_gantt_close(e, TRACE_END_EXIT);
+        ENGINE_OP(dequeue)(rq, e, x, DEQUEUE_EXIT);
+        e->curr = NULL;
+    } else if (io_block(x, e->now)) {
+        engine_gantt_close(e, TRACE_END_SLEEP);
+        ENGINE_OP(dequeue)(rq, e, x, DEQUEUE_SLEEP);
+        e->curr = NULL;
+    } else if (action != TICK_CONTINUE) {
+        if (action == TICK_YIELD) engine_gantt_close(e, TRACE_END_YIELD);
+        e->need_resched = true;
+        e->resched_reason = TRACE_END_RESCHED;
+    }
+}
+
+static void ENGINE_OP(engine_run)(SimEngine *e, SCHED_RQ *rq) {
+    ENGINE_OP(init)(rq, e);
+    while (e->completed < e->n && !sim_should_stop(e->now)) {
+        ENGINE_OP(engine_step)(e, rq);
+    }
+}
+
+#undef ENGINE_OP
+#undef ENGINE_PASTE
+#undef ENGINE_PASTE2
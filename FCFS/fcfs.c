@@ -1,13 +1,21 @@
 #include "fcfs.h"
+#include "Engine/engine.h"
+#include "IO/io.h"
 
-// Standard FCFS (Non-preemptive by definition, but simulates purely on arrival)
-void run_fcfs(Process p[], int n) {
-    printf("Starting Simulation (FCFS)...\n");
-    int current_time = 0;
-    int completed = 0;
-    reset_processes(p, n);
+// --- FCFS Scheduling Class ---
+// Non-preemptive: the task that has been ready the longest runs its whole
+// CPU burst. Without I/O this is simply arrival order.
+
+typedef struct {
+    int unused;
+} FcfsRq;
+
+static void fcfs_init(FcfsRq *rq, SimEngine *e) {
+    (void)rq;
+    Process *p = e->p;
+    int n = e->n;
 
-    // Simple bubble sort by Arrival Time
+    // Simple bubble sort by Arrival Time (stable, so results list in arrival order)
     for(int i=0; i<n-1; i++) {
         for(int j=0; j<n-i-1; j++) {
             if(p[j].at > p[j+1].at) {
@@ -15,27 +23,60 @@ void run_fcfs(Process p[], int n) {
             }
         }
     }
+    engine_sort_arrivals(e);
+}
+
+static void fcfs_enqueue(FcfsRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)x; (void)flags;
+}
 
-    for(int i=0; i<n; i++) {
-        if(current_time < p[i].at) current_time = p[i].at;
-        
-        p[i].start_time = current_time;
-        p[i].rt = p[i].start_time - p[i].at;
-        
-        // Log Gantt event - FCFS has solid blocks (no preemption)
-        int gantt_start = current_time;
-        
-        current_time += p[i].bt;
-        
-        // Log the complete execution block
-        add_gantt_event(p[i].pid, gantt_start, current_time);
-        
-        p[i].ct = current_time;
-        p[i].tat = p[i].ct - p[i].at;
-        p[i].wt = p[i].tat - p[i].bt;
-        p[i].rem_bt = 0;
-        p[i].completed = true;
+static bool fcfs_check_preempt(FcfsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return false;
+}
+
+static Process* fcfs_pick_next(FcfsRq *rq, SimEngine *e) {
+    (void)rq;
+    Process *p = e->p;
+    int idx = -1;
+    for(int i=0; i<e->n; i++) {
+        if(p[i].at <= e->now && !p[i].completed && !p[i].blocked) {
+            if(idx == -1 || p[i].ready_since < p[idx].ready_since) idx = i;
+        }
     }
-    print_table(p, n, "FCFS Scheduling");
+    return (idx == -1) ? NULL : &p[idx];
+}
+
+static void fcfs_set_next(FcfsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
 }
 
+// Run the whole CPU burst
+static int fcfs_run_length(FcfsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e;
+    return io_cpu_left(x);
+}
+
+static int fcfs_tick(FcfsRq *rq, SimEngine *e, Process *x, int ran) {
+    (void)rq; (void)e; (void)x; (void)ran;
+    return TICK_CONTINUE; // The burst always ends in exit or sleep
+}
+
+static void fcfs_dequeue(FcfsRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)x; (void)flags;
+}
+
+#define SCHED_CLASS fcfs
+#define SCHED_RQ FcfsRq
+#include "Engine/engine_loop.h"
+
+void run_fcfs(Process p[], int n) {
+    if (!sim_quiet) printf("Starting Simulation (FCFS)...\n");
+
+    SimEngine e;
+    FcfsRq rq;
+    engine_init(&e, p, n);
+    fcfs_engine_run(&e, &rq);
+
+    print_table(p, n, "FCFS Scheduling");
+}
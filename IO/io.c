@@ -0,0 +1,159 @@
+#include <string.h>
+#include "io.h"
+
+bool io_enabled = false;
+
+// --- Sleep Queue (binary min-heap on wakeup time) ---
+static THREAD_LOCAL SleepEntry *sleepq = NULL;
+static THREAD_LOCAL int sleepq_count = 0;
+static THREAD_LOCAL int sleepq_capacity = 0;
+
+void sleepq_reset(void) {
+    sleepq_count = 0;
+}
+
+void sleepq_free(void) {
+    free(sleepq);
+    sleepq = NULL;
+    sleepq_count = 0;
+    sleepq_capacity = 0;
+}
+
+static void sleepq_push(int wake_time, Process *p) {
+    if (sleepq_count == sleepq_capacity) {
+        sleepq_capacity = sleepq_capacity ? sleepq_capacity * 2 : 64;
+        sleepq = (SleepEntry*)realloc(sleepq, sleepq_capacity * sizeof(SleepEntry));
+    }
+
+    // Sift up
+    int i = sleepq_count++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (sleepq[parent].wake_time <= wake_time) break;
+        sleepq[i] = sleepq[parent];
+        i = parent;
+    }
+    sleepq[i].wake_time = wake_time;
+    sleepq[i].process = p;
+}
+
+static SleepEntry sleepq_pop(void) {
+    SleepEntry top = sleepq[0];
+    SleepEntry last = sleepq[--sleepq_count];
+
+    // Sift down
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= sleepq_count) break;
+        if (child + 1 < sleepq_count && sleepq[child + 1].wake_time < sleepq[child].wake_time)
+            child++;
+        if (last.wake_time <= sleepq[child].wake_time) break;
+        sleepq[i] = sleepq[child];
+        i = child;
+    }
+    if (sleepq_count > 0) sleepq[i] = last;
+    return top;
+}
+
+int io_next_wakeup(void) {
+    return (sleepq_count > 0) ? sleepq[0].wake_time : -1;
+}
+
+// The heap array is copied as-is, so restoring preserves its exact layout
+int sleepq_save(SleepEntry **out) {
+    *out = NULL;
+    if (sleepq_count == 0) return 0;
+    *out = (SleepEntry*)malloc(sleepq_count * sizeof(SleepEntry));
+    memcpy(*out, sleepq, sleepq_count * sizeof(SleepEntry));
+    return sleepq_count;
+}
+
+void sleepq_restore(const SleepEntry *entries, int count) {
+    if (count > sleepq_capacity) {
+        sleepq_capacity = count;
+        sleepq = (SleepEntry*)realloc(sleepq, sleepq_capacity * sizeof(SleepEntry));
+    }
+    if (count > 0) memcpy(sleepq, entries, count * sizeof(SleepEntry));
+    sleepq_count = count;
+}
+
+// --- Per-Process Burst State ---
+
+void io_reset_process(Process *p) {
+    p->burst_idx = 0;
+    p->next_block_at = (p->bursts != NULL) ? p->bursts[0] : p->bt;
+    p->blocked = false;
+    p->ready_since = p->at;
+    p->wake_pending = false;
+    p->wakeups = 0;
+    p->sched_lat_total = 0;
+    p->sched_lat_max = 0;
+}
+
+bool io_block(Process *p, int now) {
+    if (p->bursts == NULL || p->rem_bt == 0) return false;
+    if (p->bt - p->rem_bt != p->next_block_at) return false;
+
+    // Current CPU burst is done: sleep for the following I/O phase
+    int io_len = p->bursts[p->burst_idx + 1];
+    p->burst_idx += 2;
+    p->next_block_at += p->bursts[p->burst_idx];
+    p->blocked = true;
+    sleepq_push(now + io_len, p);
+    return true;
+}
+
+int io_cpu_left(Process *p) {
+    if (p->bursts == NULL) return p->rem_bt;
+    return p->next_block_at - (p->bt - p->rem_bt);
+}
+
+Process* io_pop_wakeup(int now) {
+    if (sleepq_count == 0 || sleepq[0].wake_time > now) return NULL;
+
+    SleepEntry e = sleepq_pop();
+    e.process->blocked = false;
+    e.process->ready_since = e.wake_time;
+    e.process->wake_pending = true;
+    return e.process;
+}
+
+void io_wakeup_all(int now) {
+    while (io_pop_wakeup(now) != NULL) {}
+}
+
+void io_note_dispatch(Process *p, int now) {
+    if (!p->wake_pending) return;
+
+    int lat = now - p->ready_since;
+    p->wake_pending = false;
+    p->wakeups++;
+    p->sched_lat_total += lat;
+    if (lat > p->sched_lat_max) p->sched_lat_max = lat;
+}
+
+// --- Reporting ---
+void print_io_latency(Process p[], int n) {
+    long total_lat = 0;
+    long total_wakeups = 0;
+    int worst = 0;
+
+    printf("\n--- I/O Wakeup Latency ---\n\n");
+    printf("PID\tIO\tWakeups\tAvgLat\tMaxLat\n");
+    for (int i = 0; i < n; i++) {
+        double avg = (p[i].wakeups > 0) ? (double)p[i].sched_lat_total / p[i].wakeups : 0.0;
+        printf("%d\t%d\t%d\t%.2f\t%d\n",
+               p[i].pid, p[i].io_time, p[i].wakeups, avg, p[i].sched_lat_max);
+
+        total_lat += p[i].sched_lat_total;
+        total_wakeups += p[i].wakeups;
+        if (p[i].sched_lat_max > worst) worst = p[i].sched_lat_max;
+    }
+
+    printf("\n");
+    printf("Total Wakeups              = %ld\n", total_wakeups);
+    printf("Mean Wakeup Latency        = %.2f\n",
+           (total_wakeups > 0) ? (double)total_lat / total_wakeups : 0.0);
+    printf("Max Wakeup Latency         = %d\n", worst);
+}
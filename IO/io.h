@@ -0,0 +1,54 @@
+#ifndef IO_H
+#define IO_H
+
+#include "common.h"
+
+// --- CPU/IO Burst Model ---
+// A process with bursts != NULL alternates CPU and I/O phases:
+//   bursts = { cpu0, io0, cpu1, io1, ..., cpuK }   (burst_count = 2K + 1)
+// p->bt holds the total CPU demand and rem_bt counts down across all CPU
+// bursts, so schedulers keep using "rem_bt == 0" for completion. The end of
+// the current CPU burst is tracked as a mark on the executed CPU time.
+//
+// Blocked processes sit in a sleep queue (binary min-heap keyed by wakeup
+// time) until their I/O finishes; schedulers drain it every tick.
+
+extern bool io_enabled; // Set by main.c when the workload has I/O phases
+
+void io_reset_process(Process *p);
+void sleepq_reset(void);
+void sleepq_free(void); // Releases this thread's heap storage
+
+// Called after a process executed CPU time without completing.
+// Returns true (and puts it to sleep) if its current CPU burst just ended.
+bool io_block(Process *p, int now);
+
+// CPU time left before the process completes or blocks on I/O
+int io_cpu_left(Process *p);
+
+// Pops one process whose I/O finished at or before 'now' (NULL if none).
+// The process is marked runnable again with ready_since = its wakeup time.
+Process* io_pop_wakeup(int now);
+
+// Convenience for scan-based schedulers that only need the blocked flag cleared
+void io_wakeup_all(int now);
+
+// Earliest pending wakeup time, or -1 if the sleep queue is empty
+int io_next_wakeup(void);
+
+// Records wakeup-to-run latency if the process is dispatched after a wakeup
+void io_note_dispatch(Process *p, int now);
+
+void print_io_latency(Process p[], int n);
+
+// --- Checkpoint Support ---
+typedef struct {
+    int wake_time;
+    Process *process;
+} SleepEntry;
+
+// Copies the sleep queue into a malloc'd array (caller frees), returns count
+int sleepq_save(SleepEntry **out);
+void sleepq_restore(const SleepEntry *entries, int count);
+
+#endif
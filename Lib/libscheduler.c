@@ -0,0 +1,224 @@
+#include <stddef.h>
+#include <string.h>
+#include "libscheduler.h"
+#include "common.h"
+#include "Arena/arena.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "FCFS/fcfs.h"
+#include "Priority/priority.h"
+#include "SJF/sjf.h"
+#include "RR/rr.h"
+#include "MLFQ/mlfq.h"
+#include "EDF/edf.h"
+#include "PropShare/propshare.h"
+#include "RMS/rms.h"
+#include "CFS/cfs.h"
+#include "EEVDF/eevdf.h"
+#include "RT/rt.h"
+#include "Steal/steal.h"
+
+// Results point straight at the logs, so the public records must match them
+#define LAYOUT_CHECK(name, cond) typedef char name[(cond) ? 1 : -1]
+LAYOUT_CHECK(gantt_size, sizeof(SchedulerGanttEvent) == sizeof(GanttEvent));
+LAYOUT_CHECK(gantt_end, offsetof(SchedulerGanttEvent, end) == offsetof(GanttEvent, end_time));
+LAYOUT_CHECK(vruntime_size, sizeof(SchedulerVRuntimeSegment) == sizeof(VRuntimeSegment));
+LAYOUT_CHECK(vruntime_rate, offsetof(SchedulerVRuntimeSegment, rate) == offsetof(VRuntimeSegment, rate));
+LAYOUT_CHECK(gantt_cap, SCHEDULER_MAX_GANTT == MAX_GANTT_EVENTS);
+LAYOUT_CHECK(vruntime_cap, SCHEDULER_MAX_VRUNTIME == MAX_VRUNTIME_LOGS);
+LAYOUT_CHECK(vruntime_scale, SCHEDULER_VRUNTIME_SCALE == VRUNTIME_SCALE);
+
+// --- Tunables ---
+// The per-thread tunables a run changes, put back afterwards so the next
+// call on the thread starts from its own parameters only
+
+typedef struct {
+    int sched_latency, sched_min_granularity, mlfq_quantum;
+    uint64_t lottery_seed, lottery_stream;
+    bool sim_quiet;
+} SavedTunables;
+
+static void save_tunables(SavedTunables *t) {
+    t->sched_latency = sched_latency;
+    t->sched_min_granularity = sched_min_granularity;
+    t->mlfq_quantum = mlfq_quantum;
+    t->lottery_seed = lottery_seed;
+    t->lottery_stream = lottery_stream;
+    t->sim_quiet = sim_quiet;
+}
+
+static void restore_tunables(const SavedTunables *t) {
+    sched_latency = t->sched_latency;
+    sched_min_granularity = t->sched_min_granularity;
+    mlfq_quantum = t->mlfq_quantum;
+    lottery_seed = t->lottery_seed;
+    lottery_stream = t->lottery_stream;
+    sim_quiet = t->sim_quiet;
+}
+
+// --- Task Table ---
+
+// The fields main.c reads for the same algorithm; the rest stay zero
+static bool load_task(Process *x, const SchedulerTask *t, int i, const SchedulerParams *params) {
+    int algo = params->algorithm;
+    if (t->bt < 1 || t->at < 0) return false; // A zero burst never completes in some classes
+    x->pid = i + 1;
+    x->at = t->at;
+    x->bt = t->bt;
+    x->rem_bt = t->bt;
+    x->policy = POLICY_NORMAL;
+    x->burst_count = 1;
+    x->last_ran = -1;
+
+    if ((algo == SCHEDULER_CFS || algo == SCHEDULER_EEVDF) && params->use_nice) {
+        x->nice = (t->nice < -20) ? -20 : (t->nice > 19) ? 19 : t->nice;
+    } else if (algo == SCHEDULER_PRIORITY || algo == SCHEDULER_CFS || algo == SCHEDULER_EEVDF) {
+        x->priority = t->priority;
+        x->nice = prio_to_nice(t->priority);
+    }
+
+    if (algo == SCHEDULER_EDF) x->deadline = t->deadline;
+    if (algo == SCHEDULER_RMS) x->period = t->period;
+    if (algo == SCHEDULER_PROPSHARE) {
+        if (t->tickets <= 0) return false;
+        x->tickets = t->tickets;
+    }
+    if (algo == SCHEDULER_WORK_STEALING && t->dep_count > 0) {
+        if (t->deps == NULL) return false;
+        x->deps = (int*)t->deps; // Read only; invalid PIDs are ignored
+        x->dep_count = t->dep_count;
+    }
+    return true;
+}
+
+static void store_results(SchedulerTask tasks[], const Process p[], int n) {
+    // Some classes reorder the table (FCFS sorts it by arrival)
+    for (int i = 0; i < n; i++) {
+        SchedulerTask *t = &tasks[p[i].pid - 1];
+        t->start_time = p[i].start_time;
+        t->ct = p[i].ct;
+        t->wt = p[i].wt;
+        t->tat = p[i].tat;
+        t->rt = p[i].rt;
+    }
+}
+
+// The print_table summary, without the printing
+static void summarize(Process p[], int n, double capacity, SchedulerResult *r) {
+    SimMetrics m;
+    compute_metrics(p, n, &m);
+
+    long total_burst = 0;
+    int min_at = p[0].at;
+    for (int i = 0; i < n; i++) {
+        total_burst += p[i].bt;
+        if (p[i].at < min_at) min_at = p[i].at;
+    }
+    double total_time = m.makespan - min_at;
+    if (total_time <= 0) total_time = 1;
+    double cpu_time = total_time * capacity;
+    long total_overhead = cs_switch_overhead + cs_cache_overhead;
+
+    r->avg_wt = m.avg_wt;
+    r->avg_tat = m.avg_tat;
+    r->avg_rt = m.avg_rt;
+    r->p99_rt = m.p99_rt;
+    r->p99_tat = m.p99_tat;
+    r->cpu_util = (total_burst + total_overhead) / cpu_time * 100.0;
+    r->effective_cpu_util = total_burst / cpu_time * 100.0;
+    r->throughput = n / total_time;
+    r->fairness = calculate_jain_fairness(p, n);
+    r->context_switches = m.context_switches;
+    r->switch_overhead = cs_switch_overhead;
+    r->cache_overhead = cs_cache_overhead;
+    r->makespan = m.makespan;
+}
+
+// --- API ---
+
+int scheduler_api_version(void) {
+    return SCHEDULER_API_VERSION;
+}
+
+void scheduler_default_params(SchedulerParams *params, int algorithm) {
+    memset(params, 0, sizeof(*params));
+    params->version = SCHEDULER_API_VERSION;
+    params->algorithm = algorithm;
+    params->time_quantum = 2;
+    params->mlfq_quantum = MLFQ_DEFAULT_QUANTUM;
+    params->sched_latency = SCHED_LATENCY;
+    params->min_granularity = MIN_GRANULARITY;
+    params->workers = STEAL_DEFAULT_WORKERS;
+    params->steal_cost = STEAL_DEFAULT_COST;
+}
+
+void scheduler_set_costs(int switch_cost, int cache_penalty, int cache_decay) {
+    cs_switch_cost = (switch_cost > 0) ? switch_cost : 0;
+    cs_cache_penalty = (cache_penalty > 0) ? cache_penalty : 0;
+    cs_cache_decay = (cache_decay > 0) ? cache_decay : 0;
+}
+
+int scheduler_run(SchedulerTask *tasks, int n, const SchedulerParams *params, SchedulerResult *result) {
+    if (params == NULL || params->version != SCHEDULER_API_VERSION) return SCHEDULER_ERR_VERSION;
+    if (tasks == NULL || result == NULL || n <= 0) return SCHEDULER_ERR_ARGS;
+    int algo = params->algorithm;
+    if (algo < SCHEDULER_FCFS || algo > SCHEDULER_WORK_STEALING) return SCHEDULER_ERR_ALGORITHM;
+
+    ArenaMark mark = arena_mark(&run_arena);
+    Process *p = (Process*)arena_calloc(&run_arena, n, sizeof(Process));
+    for (int i = 0; i < n; i++) {
+        if (!load_task(&p[i], &tasks[i], i, params)) {
+            arena_rewind(&run_arena, mark);
+            return SCHEDULER_ERR_ARGS;
+        }
+    }
+
+    SavedTunables saved;
+    save_tunables(&saved);
+    sim_quiet = true;
+    sched_latency = (params->sched_latency > 0) ? params->sched_latency : 1;
+    sched_min_granularity = (params->min_granularity > 0) ? params->min_granularity : 1;
+    mlfq_quantum = (params->mlfq_quantum > 0) ? params->mlfq_quantum : 1;
+    lottery_seed = params->seed;
+    lottery_stream = 0;
+
+    StealConfig steal_cfg = { params->workers, params->steal_cost };
+    if (steal_cfg.workers < 1) steal_cfg.workers = 1;
+    if (steal_cfg.workers > STEAL_MAX_WORKERS) steal_cfg.workers = STEAL_MAX_WORKERS;
+    if (steal_cfg.steal_cost < 0) steal_cfg.steal_cost = 0;
+    double capacity = 1.0;
+
+    switch (algo) {
+        case SCHEDULER_FCFS: run_fcfs(p, n); break;
+        case SCHEDULER_PRIORITY: run_priority(p, n); break;
+        case SCHEDULER_SJF: run_sjf(p, n); break;
+        case SCHEDULER_RR: run_rr(p, n, (params->time_quantum > 0) ? params->time_quantum : 1); break;
+        case SCHEDULER_MLFQ: run_mlfq(p, n); break;
+        case SCHEDULER_EDF: run_edf(p, n); break;
+        case SCHEDULER_PROPSHARE: run_propshare(p, n); break;
+        case SCHEDULER_RMS: run_rms(p, n); break;
+        case SCHEDULER_CFS: run_cfs(p, n); break;
+        case SCHEDULER_EEVDF: run_eevdf(p, n); break;
+        case SCHEDULER_WORK_STEALING:
+            run_steal(p, n, &steal_cfg);
+            capacity = steal_cfg.workers;
+            break;
+    }
+    // print_table closes the open vruntime segments, but quiet runs skip it
+    vruntime_log_flush();
+    restore_tunables(&saved);
+
+    store_results(tasks, p, n);
+    memset(result, 0, sizeof(*result));
+    summarize(p, n, capacity, result);
+    result->gantt = (const SchedulerGanttEvent*)gantt_log;
+    result->gantt_count = gantt_log_count;
+    result->vruntime = (const SchedulerVRuntimeSegment*)vruntime_log;
+    result->vruntime_count = vruntime_log_count;
+
+    arena_rewind(&run_arena, mark);
+    return SCHEDULER_OK;
+}
+
+void scheduler_release_thread(void) {
+    sim_release_thread();
+}
@@ -0,0 +1,158 @@
+#ifndef LIBSCHEDULER_H
+#define LIBSCHEDULER_H
+
+#include <stdint.h>
+
+// --- Embeddable Simulator API (libscheduler) ---
+// The shared library runs the same simulations as the CLI in-process: the
+// caller passes a task array, an algorithm and its parameters, and gets the
+// per-task results written into that array plus summary metrics and
+// pointers to the Gantt and vruntime logs. Nothing is printed or parsed.
+// Meant for ctypes/cffi callers (scheduler_dashboard/libscheduler.py) that
+// run many simulations per second.
+//
+// Only this header is public; everything else in the library is hidden.
+// Structures only grow at the end, and SchedulerParams carries the
+// version it was initialized for, so a caller built against an older
+// header keeps working or gets SCHEDULER_ERR_VERSION.
+//
+// Tasks are numbered by array position: the task at index i has PID i + 1
+// in the timeline logs and in work-stealing dependencies.
+//
+// Threads: all simulator state is per thread, so calls on different
+// threads run in parallel. The Gantt and vruntime buffers in a result
+// belong to the calling thread and stay valid until its next
+// scheduler_run or scheduler_release_thread. The switch and cache costs
+// are process-wide (scheduler_set_costs).
+//
+// Not covered (CLI only): I/O phases, CFS groups, RT classes, multi-CPU
+// topologies, what-if runs, tuning, Monte Carlo, streaming, task classes
+// and load sweeps.
+
+#define SCHEDULER_API_VERSION 1
+
+#if defined(_WIN32)
+#if defined(SCHEDULER_BUILD_LIB)
+#define SCHEDULER_API __declspec(dllexport)
+#else
+#define SCHEDULER_API __declspec(dllimport)
+#endif
+#else
+#define SCHEDULER_API __attribute__((visibility("default")))
+#endif
+
+// Algorithm IDs, the same as the CLI menu
+#define SCHEDULER_FCFS          1
+#define SCHEDULER_PRIORITY      2
+#define SCHEDULER_SJF           3
+#define SCHEDULER_RR            4
+#define SCHEDULER_MLFQ          5
+#define SCHEDULER_EDF           6
+#define SCHEDULER_PROPSHARE     7
+#define SCHEDULER_RMS           8
+#define SCHEDULER_CFS           9
+#define SCHEDULER_EEVDF         10
+#define SCHEDULER_WORK_STEALING 11
+
+// scheduler_run status
+#define SCHEDULER_OK             0
+#define SCHEDULER_ERR_ARGS      -1   // NULL pointer, no tasks, or a task the algorithm cannot take
+#define SCHEDULER_ERR_ALGORITHM -2   // Unknown algorithm ID
+#define SCHEDULER_ERR_VERSION   -3   // params not from scheduler_default_params of this version
+
+// Log capacities: later segments are dropped, as in the CLI
+#define SCHEDULER_MAX_GANTT    1000
+#define SCHEDULER_MAX_VRUNTIME 1000
+
+// vruntime values are fixed point, this many units per nice-0 tick
+#define SCHEDULER_VRUNTIME_SCALE (1LL << 20)
+
+typedef struct {
+    // Input
+    int at;                   // Arrival time, >= 0
+    int bt;                   // Burst time, >= 1
+    int priority;             // 0-9: Priority, and the CFS/EEVDF weight unless use_nice
+    int nice;                 // -20..19 for CFS/EEVDF with use_nice
+    int tickets;              // Prop Share, > 0
+    int deadline;             // EDF, relative to arrival
+    int period;               // RMS
+    const int *deps;          // Work stealing: PIDs of earlier tasks it joins on
+    int dep_count;
+
+    // Output
+    int start_time;           // First dispatch
+    int ct;                   // Completion time
+    int wt;                   // Waiting time
+    int tat;                  // Turnaround time
+    int rt;                   // Response time
+} SchedulerTask;
+
+typedef struct {
+    int version;              // SCHEDULER_API_VERSION, set by scheduler_default_params
+    int algorithm;            // SCHEDULER_*
+    int time_quantum;         // RR (default 2)
+    int mlfq_quantum;         // MLFQ Q0 quantum (default 2)
+    int sched_latency;        // CFS target latency (default 6)
+    int min_granularity;      // CFS minimum slice (default 1)
+    int use_nice;             // CFS/EEVDF weights from SchedulerTask.nice instead of priority
+    uint64_t seed;            // Prop Share lottery, work-stealing victims (0 = from the clock)
+    int workers;              // Work stealing (default 4)
+    int steal_cost;           // Work stealing, ticks per steal attempt (default 1)
+} SchedulerParams;
+
+// Same layout as the simulator's own logs, so results point straight at them
+typedef struct {
+    int pid;
+    int start;
+    int end;
+} SchedulerGanttEvent;
+
+// One run of a task: vruntime(t) = vruntime + (t - start) * rate for t in
+// start..end, in SCHEDULER_VRUNTIME_SCALE units
+typedef struct {
+    int pid;
+    int start;
+    int end;
+    int64_t vruntime;
+    int64_t rate;
+} SchedulerVRuntimeSegment;
+
+typedef struct {
+    double avg_wt;
+    double avg_tat;
+    double avg_rt;
+    double p99_rt;
+    double p99_tat;
+    double cpu_util;              // Percent, switch and cache overhead count as busy
+    double effective_cpu_util;    // Percent, only ticks that advanced a task
+    double throughput;            // Tasks per tick
+    double fairness;              // Jain's index
+    int64_t context_switches;
+    int64_t switch_overhead;      // Ticks
+    int64_t cache_overhead;       // Ticks
+    int makespan;                 // Last completion time
+
+    const SchedulerGanttEvent *gantt;
+    int gantt_count;
+    const SchedulerVRuntimeSegment *vruntime;   // CFS and EEVDF only
+    int vruntime_count;
+} SchedulerResult;
+
+SCHEDULER_API int scheduler_api_version(void);
+
+// Defaults for an algorithm; adjust fields afterwards
+SCHEDULER_API void scheduler_default_params(SchedulerParams *params, int algorithm);
+
+// Runs one simulation; results go into tasks[] and *result
+SCHEDULER_API int scheduler_run(SchedulerTask *tasks, int n, const SchedulerParams *params,
+                                SchedulerResult *result);
+
+// Context-switch and cache model (CtxSwitch/ctxswitch.h), process-wide:
+// set before starting simulations on other threads. All default to 0.
+SCHEDULER_API void scheduler_set_costs(int switch_cost, int cache_penalty, int cache_decay);
+
+// Frees the calling thread's buffers (arena blocks, sleep queue); call
+// before a thread that ran simulations exits
+SCHEDULER_API void scheduler_release_thread(void);
+
+#endif
@@ -0,0 +1,300 @@
+#include <string.h>
+#include <math.h>
+#include "load.h"
+#include "Arena/arena.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "FCFS/fcfs.h"
+#include "Priority/priority.h"
+#include "SJF/sjf.h"
+#include "RR/rr.h"
+#include "MLFQ/mlfq.h"
+#include "PropShare/propshare.h"
+#include "CFS/cfs.h"
+#include "EEVDF/eevdf.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define LOAD_THREADS 1
+#endif
+
+static const int default_loads[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90, 95, 99 };
+
+// --- Random Draws ---
+
+// splitmix64: the same draws on every platform and thread count
+static uint64_t draw_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform in (0, 1]
+static double draw_unit(uint64_t *state) {
+    return ((draw_next(state) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// --- Sweep State ---
+
+typedef struct {
+    double offered;           // Utilization the generated arrivals ask for, percent
+    double avg_rt, p99_rt;
+    double avg_tat, p99_tat;
+    double avg_wt;
+    long switches;
+    int makespan;
+} LoadPoint;
+
+typedef struct {
+    int algo;
+    const Process *mix;
+    int mix_n;
+    int time_quantum;
+    double mean_burst;
+
+    // One draw per generated task, shared by every load point
+    int total;                // warmup + tasks + warmup
+    int warmup;
+    int tasks;
+    double *gap;              // Unit-mean exponential interarrival gaps
+    int *pick;                // Task of the mix each arrival copies
+
+    const int *loads;
+    int load_count;
+    LoadPoint *points;
+    int next;
+
+    // Tunables set on the main thread, applied on every worker
+    int sched_latency, sched_min_granularity, mlfq_quantum;
+    uint64_t seed;
+#ifdef LOAD_THREADS
+    pthread_mutex_t lock;
+#endif
+} LoadSweep;
+
+#ifdef LOAD_THREADS
+#define SWEEP_LOCK(s) pthread_mutex_lock(&(s)->lock)
+#define SWEEP_UNLOCK(s) pthread_mutex_unlock(&(s)->lock)
+#else
+#define SWEEP_LOCK(s) ((void)0)
+#define SWEEP_UNLOCK(s) ((void)0)
+#endif
+
+// --- One Load Point ---
+
+static void run_algo(const LoadSweep *s, Process p[], int n, int idx) {
+    sched_latency = s->sched_latency;
+    sched_min_granularity = s->sched_min_granularity;
+    mlfq_quantum = s->mlfq_quantum;
+    lottery_seed = s->seed;
+    lottery_stream = (uint64_t)idx;
+    switch (s->algo) {
+        case 1: run_fcfs(p, n); break;
+        case 2: run_priority(p, n); break;
+        case 3: run_sjf(p, n); break;
+        case 4: run_rr(p, n, s->time_quantum); break;
+        case 5: run_mlfq(p, n); break;
+        case 7: run_propshare(p, n); break;
+        case 9: run_cfs(p, n); break;
+        case 10: run_eevdf(p, n); break;
+    }
+}
+
+static void run_point(LoadSweep *s, int idx) {
+    int n = s->total;
+    Process *p = (Process*)arena_alloc(&run_arena, n * sizeof(Process));
+
+    // Gaps scaled so that arrivals bring load% of one CPU on average
+    double scale = s->mean_burst * 100.0 / s->loads[idx];
+    double t = 0.0;
+    long demand = 0;
+    for (int j = 0; j < n; j++) {
+        t += s->gap[j] * scale;
+        p[j] = s->mix[s->pick[j]];
+        p[j].pid = j + 1;
+        p[j].at = (int)t;
+        demand += p[j].bt;
+    }
+
+    run_algo(s, p, n, idx);
+
+    LoadPoint *r = &s->points[idx];
+    double *rts = (double*)arena_alloc(&run_arena, s->tasks * sizeof(double));
+    double *tats = (double*)arena_alloc(&run_arena, s->tasks * sizeof(double));
+    double sum_rt = 0, sum_tat = 0, sum_wt = 0;
+    int makespan = 0;
+    for (int k = 0; k < s->tasks; k++) {
+        const Process *x = &p[s->warmup + k];
+        rts[k] = x->rt;
+        tats[k] = x->tat;
+        sum_rt += x->rt;
+        sum_tat += x->tat;
+        sum_wt += x->wt;
+    }
+    for (int j = 0; j < n; j++) {
+        if (p[j].ct > makespan) makespan = p[j].ct;
+    }
+
+    int span = p[n - 1].at - p[0].at;
+    r->offered = (span > 0) ? 100.0 * demand / span : 0.0;
+    r->avg_rt = sum_rt / s->tasks;
+    r->avg_tat = sum_tat / s->tasks;
+    r->avg_wt = sum_wt / s->tasks;
+    r->p99_rt = percentile(rts, s->tasks, 99.0);
+    r->p99_tat = percentile(tats, s->tasks, 99.0);
+    r->switches = cs_switch_count;
+    r->makespan = makespan;
+}
+
+// Each load point is one run, rewound afterwards
+static void* load_worker(void *arg) {
+    LoadSweep *s = (LoadSweep*)arg;
+    ArenaMark mark = arena_mark(&run_arena);
+
+    sim_quiet = true;
+    while (1) {
+        SWEEP_LOCK(s);
+        int idx = (s->next < s->load_count) ? s->next++ : -1;
+        SWEEP_UNLOCK(s);
+        if (idx < 0) break;
+        run_point(s, idx);
+        arena_rewind(&run_arena, mark);
+    }
+    sim_quiet = false;
+#ifdef LOAD_THREADS
+    SWEEP_LOCK(s);
+    arena_merge_peak(&run_arena);
+    SWEEP_UNLOCK(s);
+    sim_release_thread();
+#endif
+    return NULL;
+}
+
+// --- Report ---
+
+static void print_report(const LoadSweep *s, const char *algo_name, int threads) {
+    printf("\n--- Latency vs Load: %s ---\n\n", algo_name);
+    printf("Load %%\tOffered %%\tAvg WT\tAvg RT\tP99 RT\tAvg TAT\tP99 TAT\tSwitches\tMakespan\n");
+    int knee = -1;
+    for (int i = 0; i < s->load_count; i++) {
+        const LoadPoint *r = &s->points[i];
+        printf("%d\t%.1f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%ld\t%d\n", s->loads[i], r->offered, r->avg_wt,
+               r->avg_rt, r->p99_rt, r->avg_tat, r->p99_tat, r->switches, r->makespan);
+        if (knee == -1 && r->p99_rt > LOAD_KNEE_FACTOR * s->mean_burst) knee = s->loads[i];
+    }
+
+    printf("\n");
+    if (knee != -1) {
+        printf("Knee                       = %d%% load (P99 RT above %d mean bursts)\n", knee, LOAD_KNEE_FACTOR);
+    } else {
+        printf("Knee                       = none up to %d%% load\n", s->loads[s->load_count - 1]);
+    }
+    printf("Mean Burst                 = %.2f ticks (mix of %d tasks)\n", s->mean_burst, s->mix_n);
+    printf("Measured Tasks             = %d per load point\n", s->tasks);
+    printf("Warm-up                    = %d tasks before and %d after\n", s->warmup, s->warmup);
+    printf("Seed                       = %llu\n", (unsigned long long)s->seed);
+    printf("Threads                    = %d\n", threads);
+}
+
+// --- Entry Point ---
+
+bool load_parse_points(const char *spec, LoadConfig *cfg) {
+    cfg->load_count = 0;
+    const char *c = spec;
+    while (*c != '\0') {
+        char *end;
+        long v = strtol(c, &end, 10);
+        if (end == c || v < 1 || v > 99 || cfg->load_count == MAX_LOAD_POINTS) return false;
+        cfg->loads[cfg->load_count++] = (int)v;
+        c = end;
+        if (*c == ',') c++;
+        else if (*c != '\0') return false;
+    }
+    return cfg->load_count > 0;
+}
+
+static int compare_ints(const void *a, const void *b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+bool run_load_sweep(int algo, const Process mix[], int n, int time_quantum, LoadConfig cfg) {
+    const char *algo_name;
+    switch (algo) {
+        case 1: algo_name = "FCFS"; break;
+        case 2: algo_name = "Priority"; break;
+        case 3: algo_name = "SJF (SRTF)"; break;
+        case 4: algo_name = "RR"; break;
+        case 5: algo_name = "MLFQ"; break;
+        case 7: algo_name = "Prop Share"; break;
+        case 9: algo_name = "CFS"; break;
+        case 10: algo_name = "EEVDF"; break;
+        default:
+            printf("Load sweeps need an algorithm without periodic deadlines (not EDF or RMS).\n");
+            return false;
+    }
+    if (n <= 0) return false;
+
+    LoadSweep s;
+    memset(&s, 0, sizeof(s));
+    s.algo = algo;
+    s.mix = mix;
+    s.mix_n = n;
+    s.time_quantum = time_quantum;
+    s.tasks = (cfg.tasks > 0) ? cfg.tasks : LOAD_DEFAULT_TASKS;
+    s.warmup = (cfg.warmup >= 0) ? cfg.warmup : s.tasks / 5;
+    s.total = s.tasks + 2 * s.warmup;
+    s.seed = cfg.seed ? cfg.seed : 1;
+    s.sched_latency = sched_latency;
+    s.sched_min_granularity = sched_min_granularity;
+    s.mlfq_quantum = mlfq_quantum;
+
+    long demand = 0;
+    for (int i = 0; i < n; i++) demand += mix[i].bt;
+    s.mean_burst = (double)demand / n;
+
+    int loads[MAX_LOAD_POINTS];
+    if (cfg.load_count > 0) {
+        memcpy(loads, cfg.loads, cfg.load_count * sizeof(int));
+        s.load_count = cfg.load_count;
+    } else {
+        s.load_count = (int)(sizeof(default_loads) / sizeof(default_loads[0]));
+        memcpy(loads, default_loads, sizeof(default_loads));
+    }
+    qsort(loads, s.load_count, sizeof(int), compare_ints);
+    s.loads = loads;
+
+    uint64_t state = s.seed;
+    s.gap = (double*)arena_alloc(&run_arena, s.total * sizeof(double));
+    s.pick = (int*)arena_alloc(&run_arena, s.total * sizeof(int));
+    for (int j = 0; j < s.total; j++) {
+        s.gap[j] = -log(draw_unit(&state));
+        s.pick[j] = (int)(draw_next(&state) % (uint64_t)n);
+    }
+    s.points = (LoadPoint*)arena_calloc(&run_arena, s.load_count, sizeof(LoadPoint));
+
+    int threads = 1;
+#ifdef LOAD_THREADS
+    threads = cfg.threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > s.load_count) threads = s.load_count;
+#endif
+
+    printf("Starting Load Sweep (%s, %d load points, %d tasks each, %d threads)...\n",
+           algo_name, s.load_count, s.total, threads);
+
+#ifdef LOAD_THREADS
+    pthread_mutex_init(&s.lock, NULL);
+    pthread_t *workers = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    for (int i = 0; i < threads; i++) pthread_create(&workers[i], NULL, load_worker, &s);
+    for (int i = 0; i < threads; i++) pthread_join(workers[i], NULL);
+    free(workers);
+    pthread_mutex_destroy(&s.lock);
+#else
+    load_worker(&s);
+#endif
+
+    print_report(&s, algo_name, threads);
+    return true;
+}
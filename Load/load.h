@@ -0,0 +1,42 @@
+#ifndef LOAD_H
+#define LOAD_H
+
+#include "common.h"
+
+// --- Open-System Load Sweep ---
+// Capacity planning needs steady-state behavior, not one finite batch.
+// This mode treats the entered processes as a task mix and, for every
+// target utilization, generates an open workload: Poisson arrivals at
+// rate load / mean burst, each task a copy of a random task from the mix.
+// The first 'warmup' tasks are discarded from the statistics, and another
+// 'warmup' tasks keep arriving after the measured ones so the measured
+// tasks never see the queue drain. Every load point uses the same random
+// draws with the gaps scaled (common random numbers), so the curves are
+// smooth; load points run in parallel where pthreads are available.
+//
+// The report is a latency-vs-load table (mean and P99 of RT and TAT) and
+// the knee: the lowest load whose P99 response time exceeds
+// LOAD_KNEE_FACTOR mean bursts.
+
+#define MAX_LOAD_POINTS 32
+#define LOAD_DEFAULT_TASKS 2000
+#define LOAD_KNEE_FACTOR 10
+
+typedef struct {
+    bool enabled;
+    int loads[MAX_LOAD_POINTS];   // Target utilization in percent
+    int load_count;               // 0 = 10, 20, ..., 90, 95, 99
+    int tasks;                    // Measured tasks per point, 0 = LOAD_DEFAULT_TASKS
+    int warmup;                   // Tasks discarded at the start, -1 = tasks / 5
+    uint64_t seed;                // 0 = 1
+    int threads;                  // 0 = one per online CPU
+} LoadConfig;
+
+// Parses a comma-separated list of percentages (1..99) into cfg->loads
+bool load_parse_points(const char *spec, LoadConfig *cfg);
+
+// Returns false (without running anything) if 'algo' cannot take an open
+// workload (EDF and RMS need periodic tasks)
+bool run_load_sweep(int algo, const Process mix[], int n, int time_quantum, LoadConfig cfg);
+
+#endif
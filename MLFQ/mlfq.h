@@ -1,3 +1,7 @@
 #include "common.h"
 
+// Q0 round-robin quantum (runtime tunable, per thread)
+#define MLFQ_DEFAULT_QUANTUM 2
+extern THREAD_LOCAL int mlfq_quantum;
+
 void run_mlfq(Process p[], int n);
\ No newline at end of file
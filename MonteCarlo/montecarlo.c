@@ -0,0 +1,293 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "montecarlo.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "PropShare/propshare.h"
+#include "Arena/arena.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define MC_THREADS 1
+#endif
+
+// Replicas per batch; convergence is only checked between batches, so the
+// stopping point does not depend on how many threads share a batch
+#define MC_BATCH 8
+#define MC_MIN_REPLICAS (2 * MC_BATCH)
+
+// --- Global Metrics ---
+
+enum { M_AVG_WT, M_AVG_TAT, M_AVG_RT, M_P99_RT, M_MAKESPAN, M_SWITCHES, M_FAIRNESS, M_COUNT };
+
+static const char *metric_names[M_COUNT] = {
+    "Avg WT", "Avg TAT", "Avg RT", "P99 RT", "Makespan", "Context Switches", "Jain Fairness"
+};
+
+// --- Running Statistics (Welford) ---
+
+typedef struct {
+    long k;
+    double mean;
+    double m2;
+} Stat;
+
+static void stat_add(Stat *s, double x) {
+    s->k++;
+    double d = x - s->mean;
+    s->mean += d / s->k;
+    s->m2 += d * (x - s->mean);
+}
+
+static double stat_sd(const Stat *s) {
+    return (s->k > 1) ? sqrt(s->m2 / (s->k - 1)) : 0.0;
+}
+
+// Two-sided 97.5% quantile of Student's t
+static double t_quantile(long df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) return 0.0;
+    if (df <= 30) return table[df - 1];
+    if (df <= 40) return 2.021;
+    if (df <= 60) return 2.000;
+    if (df <= 120) return 1.980;
+    return 1.960;
+}
+
+static double stat_half_width(const Stat *s) {
+    if (s->k < 2) return 0.0;
+    return t_quantile(s->k - 1) * stat_sd(s) / sqrt((double)s->k);
+}
+
+// --- Replicas ---
+
+typedef struct {
+    double global[M_COUNT];
+    int *wt, *tat, *rt;     // Per process, n entries each
+} Replica;
+
+typedef struct {
+    int algo;
+    Process *workload;
+    int n;
+    uint64_t seed;
+
+    Replica *batch;         // MC_BATCH slots
+    int first;              // Replica index of batch[0]
+    int size;               // Replicas in the current batch
+    int next;               // Next slot to claim
+#ifdef MC_THREADS
+    pthread_mutex_t lock;
+#endif
+} Sampler;
+
+#ifdef MC_THREADS
+#define SAMPLER_LOCK(s) pthread_mutex_lock(&(s)->lock)
+#define SAMPLER_UNLOCK(s) pthread_mutex_unlock(&(s)->lock)
+#else
+#define SAMPLER_LOCK(s) ((void)0)
+#define SAMPLER_UNLOCK(s) ((void)0)
+#endif
+
+static void run_replica(int algo, Process p[], int n, uint64_t seed, int index) {
+    lottery_seed = seed;
+    lottery_stream = (uint64_t)index;
+    switch (algo) {
+        case 7: run_propshare(p, n); break;
+    }
+}
+
+static void sample(Sampler *s, int slot, Process p[]) {
+    Replica *r = &s->batch[slot];
+    SimMetrics m;
+
+    memcpy(p, s->workload, s->n * sizeof(Process));
+    run_replica(s->algo, p, s->n, s->seed, s->first + slot);
+    compute_metrics(p, s->n, &m);
+
+    r->global[M_AVG_WT] = m.avg_wt;
+    r->global[M_AVG_TAT] = m.avg_tat;
+    r->global[M_AVG_RT] = m.avg_rt;
+    r->global[M_P99_RT] = m.p99_rt;
+    r->global[M_MAKESPAN] = m.makespan;
+    r->global[M_SWITCHES] = (double)m.context_switches;
+    r->global[M_FAIRNESS] = calculate_jain_fairness(p, s->n);
+    for (int i = 0; i < s->n; i++) {
+        r->wt[i] = p[i].wt;
+        r->tat[i] = p[i].tat;
+        r->rt[i] = p[i].rt;
+    }
+}
+
+// Each replica is one run on the thread's arena, rewound afterwards
+static void* mc_worker(void *arg) {
+    Sampler *s = (Sampler*)arg;
+    ArenaMark mark = arena_mark(&run_arena);
+
+    sim_quiet = true;
+    while (1) {
+        SAMPLER_LOCK(s);
+        int slot = (s->next < s->size) ? s->next++ : -1;
+        SAMPLER_UNLOCK(s);
+        if (slot < 0) break;
+        Process *p = (Process*)arena_alloc(&run_arena, s->n * sizeof(Process));
+        sample(s, slot, p);
+        arena_rewind(&run_arena, mark);
+    }
+    sim_quiet = false;
+#ifdef MC_THREADS
+    SAMPLER_LOCK(s);
+    arena_merge_peak(&run_arena);
+    SAMPLER_UNLOCK(s);
+    sim_release_thread();
+#endif
+    return NULL;
+}
+
+static void run_batch(Sampler *s, int threads) {
+    s->next = 0;
+#ifdef MC_THREADS
+    if (threads > s->size) threads = s->size;
+    pthread_t *workers = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    for (int i = 0; i < threads; i++) pthread_create(&workers[i], NULL, mc_worker, s);
+    for (int i = 0; i < threads; i++) pthread_join(workers[i], NULL);
+    free(workers);
+#else
+    (void)threads;
+    mc_worker(s);
+#endif
+}
+
+// --- Report ---
+
+static void print_report(const char *algo_name, Process p[], int n, Stat global[],
+                         Stat *wt, Stat *tat, Stat *rt, int replicas, bool converged,
+                         MonteCarloConfig cfg, int threads) {
+    printf("\n--- Monte Carlo: %s ---\n\n", algo_name);
+    printf("Metric\tMean\tStdDev\tCI95 Low\tCI95 High\tHalf-Width %%\n");
+    for (int m = 0; m < M_COUNT; m++) {
+        double hw = stat_half_width(&global[m]);
+        double mean = global[m].mean;
+        printf("%s\t%.4f\t%.4f\t%.4f\t%.4f\t%.2f\n", metric_names[m], mean, stat_sd(&global[m]),
+               mean - hw, mean + hw, (mean != 0.0) ? 100.0 * hw / fabs(mean) : 0.0);
+    }
+
+    printf("\n--- Per-Process Means (95%% CI half-width) ---\n\n");
+    printf("PID\tAT\tBT\tTickets\tWT\tWT +/-\tTAT\tTAT +/-\tRT\tRT +/-\n");
+    for (int i = 0; i < n; i++) {
+        printf("%d\t%d\t%d\t%d\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",
+               p[i].pid, p[i].at, p[i].bt, p[i].tickets,
+               wt[i].mean, stat_half_width(&wt[i]),
+               tat[i].mean, stat_half_width(&tat[i]),
+               rt[i].mean, stat_half_width(&rt[i]));
+    }
+
+    printf("\n");
+    printf("Replicas                   = %d of %d (%s)\n", replicas, cfg.max_replicas,
+           (cfg.ci_tol <= 0) ? "fixed count" : (converged ? "converged" : "not converged"));
+    if (cfg.ci_tol > 0) {
+        printf("CI Tolerance               = %.2f%% of mean\n", 100.0 * cfg.ci_tol);
+    }
+    printf("Base Seed                  = %llu\n", (unsigned long long)cfg.seed);
+    printf("Threads                    = %d\n", threads);
+}
+
+// --- Entry Point ---
+
+bool run_montecarlo(int algo, Process p[], int n, MonteCarloConfig cfg) {
+    const char *algo_name;
+    switch (algo) {
+        case 7: algo_name = "Proportional Share"; break;
+        default: return false;
+    }
+
+    if (cfg.seed == 0) cfg.seed = (uint64_t)time(NULL);
+    if (cfg.max_replicas < 2) cfg.max_replicas = 2;
+
+    int threads = 1;
+#ifdef MC_THREADS
+    threads = cfg.threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > MC_BATCH) threads = MC_BATCH;
+#endif
+
+    printf("Starting Monte Carlo Simulation (%s, up to %d replicas, seed %llu, %d threads)...\n",
+           algo_name, cfg.max_replicas, (unsigned long long)cfg.seed, threads);
+
+    Sampler s;
+    s.algo = algo;
+    s.workload = p;
+    s.n = n;
+    s.seed = cfg.seed;
+    s.batch = (Replica*)malloc(MC_BATCH * sizeof(Replica));
+    for (int b = 0; b < MC_BATCH; b++) {
+        s.batch[b].wt = (int*)malloc(n * sizeof(int));
+        s.batch[b].tat = (int*)malloc(n * sizeof(int));
+        s.batch[b].rt = (int*)malloc(n * sizeof(int));
+    }
+#ifdef MC_THREADS
+    pthread_mutex_init(&s.lock, NULL);
+#endif
+
+    Stat global[M_COUNT];
+    memset(global, 0, sizeof(global));
+    Stat *wt = (Stat*)calloc(n, sizeof(Stat));
+    Stat *tat = (Stat*)calloc(n, sizeof(Stat));
+    Stat *rt = (Stat*)calloc(n, sizeof(Stat));
+
+    int done = 0;
+    bool converged = false;
+    while (done < cfg.max_replicas && !converged) {
+        s.first = done;
+        s.size = cfg.max_replicas - done;
+        if (s.size > MC_BATCH) s.size = MC_BATCH;
+        run_batch(&s, threads);
+
+        // Fold in replica order so the statistics are reproducible
+        for (int b = 0; b < s.size; b++) {
+            Replica *r = &s.batch[b];
+            for (int m = 0; m < M_COUNT; m++) stat_add(&global[m], r->global[m]);
+            for (int i = 0; i < n; i++) {
+                stat_add(&wt[i], r->wt[i]);
+                stat_add(&tat[i], r->tat[i]);
+                stat_add(&rt[i], r->rt[i]);
+            }
+        }
+        done += s.size;
+
+        if (cfg.ci_tol > 0 && done >= MC_MIN_REPLICAS) {
+            converged = true;
+            for (int m = 0; m < M_COUNT && converged; m++) {
+                if (stat_half_width(&global[m]) > cfg.ci_tol * fabs(global[m].mean)) converged = false;
+            }
+        }
+    }
+
+    print_report(algo_name, p, n, global, wt, tat, rt, done, converged, cfg, threads);
+
+    // Replica 0 re-run normally so the usual results follow
+    printf("\nRepresentative Run         = replica 0\n\n");
+    run_replica(algo, p, n, cfg.seed, 0);
+
+#ifdef MC_THREADS
+    pthread_mutex_destroy(&s.lock);
+#endif
+    for (int b = 0; b < MC_BATCH; b++) {
+        free(s.batch[b].wt);
+        free(s.batch[b].tat);
+        free(s.batch[b].rt);
+    }
+    free(s.batch);
+    free(wt);
+    free(tat);
+    free(rt);
+    return true;
+}
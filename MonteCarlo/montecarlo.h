@@ -0,0 +1,26 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include "common.h"
+
+// --- Monte Carlo Replicas ---
+// Randomized schedulers (Prop Share, 7) give a different schedule for every
+// seed, so a single run says little about the policy. This mode runs
+// independent replicas of the same workload, replica i drawing from PRNG
+// stream i of one base seed, and reports the mean of every per-process and
+// global metric with a 95% confidence interval. Replicas run in fixed-size
+// batches (in parallel where pthreads are available); after each batch the
+// run stops if every global interval is within the relative tolerance.
+// Results depend only on the seed, never on the thread count.
+
+typedef struct {
+    int max_replicas;    // Upper bound on replicas, 0 = Monte Carlo mode off
+    double ci_tol;       // Stop when CI half-width <= ci_tol * |mean|, 0 = run all
+    uint64_t seed;       // Base seed, 0 = from the clock
+    int threads;         // 0 = one per online CPU
+} MonteCarloConfig;
+
+// Returns false (without running anything) if 'algo' is deterministic
+bool run_montecarlo(int algo, Process p[], int n, MonteCarloConfig cfg);
+
+#endif
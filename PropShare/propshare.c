@@ -1,86 +1,93 @@
 #include <time.h>
-#include <stdlib.h> // For rand()
+#include <stdlib.h>
 #include "propshare.h"
+#include "Engine/engine.h"
+#include "Arena/arena.h"
 
-void run_propshare(Process p[], int n) {
-    printf("Starting Simulation (Proportional Share / Lottery)...\n");
-    reset_processes(p, n);
-    srand(time(NULL));
-
-    int current_time = 0;
-    int completed = 0;
-    
-    // Gantt tracking
-    int last_pid = -1;
-    int gantt_start = 0;
-
-    while(completed != n) {
-        int total_tickets = 0;
-        int active_indices[100];
-        int active_count = 0;
-
-        // Sum tickets for ready processes
-        for(int i=0; i<n; i++) {
-            if(p[i].at <= current_time && !p[i].completed) {
-                // Use tickets field instead of priority
-                total_tickets += p[i].tickets; 
-                active_indices[active_count++] = i;
-            }
-        }
+THREAD_LOCAL uint64_t lottery_seed = 0;
+THREAD_LOCAL uint64_t lottery_stream = 0;
+
+// --- PCG32 (O'Neill), one generator per thread ---
+static THREAD_LOCAL uint64_t pcg_state = 0;
+static THREAD_LOCAL uint64_t pcg_inc = 1;
+
+static uint32_t pcg32_next(void) {
+    uint64_t old = pcg_state;
+    pcg_state = old * 6364136223846793005ULL + pcg_inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+static void pcg32_seed(uint64_t seed, uint64_t stream) {
+    pcg_state = 0;
+    pcg_inc = (stream << 1) | 1;
+    pcg32_next();
+    pcg_state += seed;
+    pcg32_next();
+}
+
+// Uniform in [0, bound) without modulo bias
+static uint32_t pcg32_bounded(uint32_t bound) {
+    uint32_t threshold = (uint32_t)(-bound) % bound;
+    while (1) {
+        uint32_t r = pcg32_next();
+        if (r >= threshold) return r % bound;
+    }
+}
+
+// --- Lottery Scheduling Class ---
+// A fresh draw every tick among the ready tasks, weighted by tickets.
+
+typedef struct {
+    int *active_indices;
+} PropShareRq;
 
-        if(total_tickets > 0) {
-            int ticket = rand() % total_tickets;
-            int current_sum = 0;
-            int idx = -1;
-
-            // Find winner
-            for(int k=0; k<active_count; k++) {
-                int i = active_indices[k];
-                // Use tickets field
-                current_sum += p[i].tickets; 
-                if(ticket < current_sum) {
-                    idx = i;
-                    break;
-                }
-            }
-
-            if(idx != -1) {
-                // Check for context switch
-                if(last_pid != p[idx].pid && last_pid != -1) {
-                    add_gantt_event(last_pid, gantt_start, current_time);
-                    gantt_start = current_time;
-                } else if(last_pid == -1) {
-                    gantt_start = current_time;
-                }
-                last_pid = p[idx].pid;
-                
-                if(!p[idx].started) {
-                    p[idx].start_time = current_time;
-                    p[idx].rt = current_time - p[idx].at;
-                    p[idx].started = true;
-                }
-                
-                p[idx].rem_bt--;
-                current_time++;
-
-                if(p[idx].rem_bt == 0) {
-                    add_gantt_event(p[idx].pid, gantt_start, current_time);
-                    last_pid = -1;
-                    
-                    p[idx].ct = current_time;
-                    p[idx].tat = p[idx].ct - p[idx].at;
-                    p[idx].wt = p[idx].tat - p[idx].bt;
-                    p[idx].completed = true;
-                    completed++;
-                }
-            }
-        } else {
-            if(last_pid != -1) {
-                add_gantt_event(last_pid, gantt_start, current_time);
-                last_pid = -1;
-            }
-            current_time++;
+static void propshare_init(PropShareRq *rq, SimEngine *e) {
+    (void)rq; (void)e;
+    pcg32_seed(lottery_seed ? lottery_seed : (uint64_t)time(NULL), lottery_stream);
+}
+
+static Process* propshare_pick_next(PropShareRq *rq, SimEngine *e) {
+    Process *p = e->p;
+    int total_tickets = 0;
+    int active_count = 0;
+
+    // Sum tickets for ready processes
+    for(int i=0; i<e->n; i++) {
+        if(p[i].at <= e->now && !p[i].completed && !p[i].blocked) {
+            // Use tickets field instead of priority
+            total_tickets += p[i].tickets;
+            rq->active_indices[active_count++] = i;
         }
     }
+    if(total_tickets <= 0) return NULL;
+
+    int ticket = (int)pcg32_bounded((uint32_t)total_tickets);
+    int current_sum = 0;
+
+    // Find winner
+    for(int k=0; k<active_count; k++) {
+        int i = rq->active_indices[k];
+        current_sum += p[i].tickets;
+        if(ticket < current_sum) return &p[i];
+    }
+    return NULL;
+}
+
+#define SCHED_CLASS propshare
+#define SCHED_RQ PropShareRq
+#define SCHED_PER_TICK
+#include "Engine/engine_loop.h"
+
+void run_propshare(Process p[], int n) {
+    if (!sim_quiet) printf("Starting Simulation (Proportional Share / Lottery)...\n");
+
+    SimEngine e;
+    PropShareRq rq;
+    rq.active_indices = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    engine_init(&e, p, n);
+    propshare_engine_run(&e, &rq);
+
     print_table(p, n, "Proportional Share");
 }
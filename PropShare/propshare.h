@@ -1,3 +1,9 @@
 #include "common.h"
 
+// Lottery draws come from a PCG32 generator owned by the calling thread.
+// lottery_seed = 0 seeds from the clock; lottery_stream selects one of 2^63
+// independent sequences for the same seed (used by Monte Carlo replicas).
+extern THREAD_LOCAL uint64_t lottery_seed;
+extern THREAD_LOCAL uint64_t lottery_stream;
+
 void run_propshare(Process p[], int n);
\ No newline at end of file
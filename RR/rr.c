@@ -1,58 +1,82 @@
 #include "rr.h"
+#include "Engine/engine.h"
+#include "IO/io.h"
 
-void run_rr(Process p[], int n, int tq) {
-    printf("Starting Simulation (RR, Time Quantum = %d)...\n", tq);
-    reset_processes(p, n);
-
-    int current_time = 0;
-    int completed = 0;
-    
-    // Sort roughly by arrival for initial queue logic
-    // (Simplification: using a loop to find available processes)
-    
-    // Check minimal arrival time
-    int min_at = p[0].at;
-    for(int i=1;i<n;i++) if(p[i].at < min_at) min_at = p[i].at;
-    current_time = min_at;
-
-    while(completed != n) {
-        bool worked = false;
-        
-        for(int i=0; i<n; i++) {
-            if(p[i].at <= current_time && !p[i].completed) {
-                worked = true;
-                if(!p[i].started) {
-                    p[i].start_time = current_time;
-                    p[i].rt = current_time - p[i].at;
-                    p[i].started = true;
-                }
-
-                int exec_time = (p[i].rem_bt > tq) ? tq : p[i].rem_bt;
-                
-                // Log Gantt event for this time slice
-                int gantt_start = current_time;
-                
-                // Advance time
-                // Note: In real RR, new processes arriving during this time 
-                // would enter queue. Here we iterate array which mimics RR 
-                // if array is sorted by AT roughly.
-                current_time += exec_time;
-                p[i].rem_bt -= exec_time;
-                
-                // Log the time slice
-                add_gantt_event(p[i].pid, gantt_start, current_time);
-
-                if(p[i].rem_bt == 0) {
-                    p[i].ct = current_time;
-                    p[i].tat = p[i].ct - p[i].at;
-                    p[i].wt = p[i].tat - p[i].bt;
-                    p[i].completed = true;
-                    completed++;
-                }
+// --- Round Robin Scheduling Class ---
+// Sweeps the task table in index order, giving each ready task one quantum.
+// This mimics a FIFO run queue when the table is roughly sorted by arrival.
+
+typedef struct {
+    int tq;
+    int cursor;     // Next index the sweep looks at
+    bool worked;    // Current sweep dispatched something
+} RrRq;
+
+static void rr_init(RrRq *rq, SimEngine *e) {
+    (void)e;
+    rq->cursor = 0;
+    rq->worked = false;
+}
+
+static void rr_enqueue(RrRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)x; (void)flags;
+}
+
+static bool rr_check_preempt(RrRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return false;
+}
+
+static Process* rr_pick_next(RrRq *rq, SimEngine *e) {
+    Process *p = e->p;
+    while (1) {
+        while (rq->cursor < e->n) {
+            int i = rq->cursor++;
+            if(p[i].at <= e->now && !p[i].completed && !p[i].blocked) {
+                rq->worked = true;
+                return &p[i];
             }
         }
-        if(!worked) current_time++;
+        // End of a sweep: start another unless this one found nothing
+        rq->cursor = 0;
+        if (!rq->worked) return NULL;
+        rq->worked = false;
     }
-    print_table(p, n, "Round Robin");
 }
 
+static void rr_set_next(RrRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+}
+
+// Run for a quantum, or less if the process completes or blocks on I/O
+static int rr_run_length(RrRq *rq, SimEngine *e, Process *x) {
+    (void)e;
+    int cpu_left = io_cpu_left(x);
+    return (cpu_left > rq->tq) ? rq->tq : cpu_left;
+}
+
+// Every quantum is its own Gantt slice, even if the same task runs again
+static int rr_tick(RrRq *rq, SimEngine *e, Process *x, int ran) {
+    (void)rq; (void)e; (void)x; (void)ran;
+    return TICK_YIELD;
+}
+
+static void rr_dequeue(RrRq *rq, SimEngine *e, Process *x, int flags) {
+    (void)rq; (void)e; (void)x; (void)flags;
+}
+
+#define SCHED_CLASS rr
+#define SCHED_RQ RrRq
+#include "Engine/engine_loop.h"
+
+void run_rr(Process p[], int n, int tq) {
+    if (!sim_quiet) printf("Starting Simulation (RR, Time Quantum = %d)...\n", tq);
+
+    SimEngine e;
+    RrRq rq;
+    rq.tq = tq;
+    engine_init(&e, p, n);
+    rr_engine_run(&e, &rq);
+
+    print_table(p, n, "Round Robin");
+}
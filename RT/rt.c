@@ -0,0 +1,264 @@
+#include "rt.h"
+#include "CFS/cfs.h"
+#include "Engine/engine.h"
+#include "Arena/arena.h"
+
+int rt_period = RT_DEFAULT_PERIOD;
+int rt_runtime = RT_DEFAULT_RUNTIME;
+int rt_timeslice = RT_DEFAULT_TIMESLICE;
+
+// --- RT Runqueue ---
+
+void rt_rq_init(RtRq *rq, int n) {
+    for (int prio = 0; prio < RT_MAX_PRIO; prio++) rq->head[prio] = rq->tail[prio] = -1;
+    for (int w = 0; w < RT_BITMAP_WORDS; w++) rq->bitmap[w] = 0;
+    for (int i = 0; i < n; i++) rq->slice[i] = rt_timeslice;
+    rq->nr_queued = 0;
+    rq->curr = NULL;
+    rq->requeue_tail = false;
+
+    rq->period_end = rt_period;
+    rq->rt_time = 0;
+    rq->throttled = false;
+    rq->throttled_at = 0;
+    rq->throttled_time = 0;
+    rq->throttle_count = 0;
+}
+
+void rt_push(RtRq *rq, Process p[], int idx, bool at_head) {
+    int prio = p[idx].rt_priority;
+    if (rq->head[prio] == -1) {
+        rq->next[idx] = -1;
+        rq->head[prio] = rq->tail[prio] = idx;
+        rq->bitmap[prio / 32] |= 1u << (prio % 32);
+    } else if (at_head) {
+        rq->next[idx] = rq->head[prio];
+        rq->head[prio] = idx;
+    } else {
+        rq->next[idx] = -1;
+        rq->next[rq->tail[prio]] = idx;
+        rq->tail[prio] = idx;
+    }
+    rq->nr_queued++;
+}
+
+int rt_top_prio(const RtRq *rq) {
+    for (int w = RT_BITMAP_WORDS - 1; w >= 0; w--) {
+        if (rq->bitmap[w] == 0) continue;
+        int bit = 31;
+        while (!(rq->bitmap[w] & (1u << bit))) bit--;
+        return w * 32 + bit;
+    }
+    return 0;
+}
+
+// Head of the highest non-empty priority list
+int rt_pop_highest(RtRq *rq) {
+    int prio = rt_top_prio(rq);
+    int w = prio / 32;
+    int bit = prio % 32;
+
+    int idx = rq->head[prio];
+    rq->head[prio] = rq->next[idx];
+    if (rq->head[prio] == -1) {
+        rq->tail[prio] = -1;
+        rq->bitmap[w] &= ~(1u << bit);
+    }
+    rq->nr_queued--;
+    return idx;
+}
+
+// Roll the bandwidth window forward; a new window lifts the throttle
+static void rt_update_period(RtRq *rq, int now) {
+    if (rt_runtime < 0) return;
+    while (now >= rq->period_end) {
+        if (rq->throttled) {
+            rq->throttled_time += rq->period_end - rq->throttled_at;
+            rq->throttled = false;
+        }
+        rq->rt_time = 0;
+        rq->period_end += rt_period;
+    }
+}
+
+// --- Stacked Scheduling Class: RT, then CFS ---
+
+typedef struct {
+    RtRq rt;
+    CfsRq cfs;
+} RtCfsRq;
+
+static bool is_rt(const Process *x) {
+    return x->policy != POLICY_NORMAL;
+}
+
+static void rt_cfs_init(RtCfsRq *rq, SimEngine *e) {
+    cfs_init(&rq->cfs, e);
+    rt_rq_init(&rq->rt, e->n);
+}
+
+static void rt_cfs_enqueue(RtCfsRq *rq, SimEngine *e, Process *x, int flags) {
+    if (is_rt(x)) rt_push(&rq->rt, e->p, (int)(x - e->p), false);
+    else cfs_enqueue(&rq->cfs, e, x, flags);
+}
+
+// A runnable RT task beats any CFS task and any lower RT priority
+static bool rt_cfs_check_preempt(RtCfsRq *rq, SimEngine *e, Process *x) {
+    if (!is_rt(x) || rq->rt.throttled) return false;
+    if (!is_rt(e->curr)) return true;
+    return x->rt_priority > e->curr->rt_priority;
+}
+
+static Process* rt_cfs_pick_next(RtCfsRq *rq, SimEngine *e) {
+    RtRq *rt = &rq->rt;
+    rt_update_period(rt, e->now);
+
+    // A preempted RT task keeps its place, an expired RR quantum goes last
+    if (rt->curr != NULL) {
+        rt_push(rt, e->p, (int)(rt->curr - e->p), !rt->requeue_tail);
+        rt->curr = NULL;
+        rt->requeue_tail = false;
+    }
+
+    e->timer = -1;
+    if (rt->nr_queued > 0) {
+        if (!rt->throttled) {
+            cfs_put_prev(&rq->cfs);
+            rt->curr = &e->p[rt_pop_highest(rt)];
+            return rt->curr;
+        }
+        e->timer = rt->period_end; // Throttled RT work resumes with the next window
+    }
+    return cfs_pick_next(&rq->cfs, e);
+}
+
+static void rt_cfs_set_next(RtCfsRq *rq, SimEngine *e, Process *x) {
+    if (!is_rt(x)) cfs_set_next(&rq->cfs, e, x);
+}
+
+// Tick by tick, so RT wakeups preempt immediately
+static int rt_cfs_run_length(RtCfsRq *rq, SimEngine *e, Process *x) {
+    (void)rq; (void)e; (void)x;
+    return 1;
+}
+
+static int rt_cfs_tick(RtCfsRq *rq, SimEngine *e, Process *x, int ran) {
+    RtRq *rt = &rq->rt;
+
+    if (!is_rt(x)) {
+        int action = cfs_tick(&rq->cfs, e, x, ran);
+        // RT work held back by throttling takes over when its window ends
+        rt_update_period(rt, e->now + ran);
+        if (rt->nr_queued > 0 && !rt->throttled) return TICK_RESCHED;
+        return action;
+    }
+
+    rt_update_period(rt, e->now);
+    int action = TICK_CONTINUE;
+
+    // SCHED_RR: rotate among equal priorities once the quantum is used up
+    if (x->policy == POLICY_RR) {
+        int *slice = &rt->slice[x - e->p];
+        *slice -= ran;
+        if (*slice <= 0) {
+            *slice = rt_timeslice;
+            if (rt->head[x->rt_priority] != -1) {
+                rt->requeue_tail = true;
+                action = TICK_YIELD;
+            }
+        }
+    }
+
+    if (rt_runtime >= 0) {
+        rt->rt_time += ran;
+        if (rt->rt_time >= rt_runtime && !rt->throttled) {
+            rt->throttled = true;
+            rt->throttled_at = e->now + ran;
+            rt->throttle_count++;
+            if (action == TICK_CONTINUE) action = TICK_RESCHED;
+        }
+    }
+    return action;
+}
+
+static void rt_cfs_dequeue(RtCfsRq *rq, SimEngine *e, Process *x, int flags) {
+    if (is_rt(x)) {
+        rq->rt.curr = NULL;
+        rq->rt.requeue_tail = false;
+    } else {
+        cfs_dequeue(&rq->cfs, e, x, flags);
+    }
+}
+
+#define SCHED_CLASS rt_cfs
+#define SCHED_RQ RtCfsRq
+#include "Engine/engine_loop.h"
+
+// --- Reporting ---
+
+void rt_print_class_table(Process p[], int n) {
+    static const char *names[3] = { "CFS", "FIFO", "RR" };
+    double *rt = (double*)malloc(n * sizeof(double));
+    double *tat = (double*)malloc(n * sizeof(double));
+
+    printf("\n--- Per-Class Results ---\n\n");
+    printf("Class\tTasks\tCPU\tAvg WT\tAvg TAT\tAvg RT\tP99 RT\tMax RT\tP99 TAT\n");
+    for (int c = POLICY_NORMAL; c <= POLICY_RR; c++) {
+        int count = 0;
+        long cpu = 0, wt = 0, tat_sum = 0, rt_sum = 0;
+        int max_rt = 0;
+        for (int i = 0; i < n; i++) {
+            if (p[i].policy != c) continue;
+            rt[count] = p[i].rt;
+            tat[count] = p[i].tat;
+            count++;
+            cpu += p[i].bt;
+            wt += p[i].wt;
+            tat_sum += p[i].tat;
+            rt_sum += p[i].rt;
+            if (p[i].rt > max_rt) max_rt = p[i].rt;
+        }
+        if (count == 0) continue;
+        printf("%s\t%d\t%ld\t%.2f\t%.2f\t%.2f\t%.2f\t%d\t%.2f\n", names[c], count, cpu,
+               (double)wt / count, (double)tat_sum / count, (double)rt_sum / count,
+               percentile(rt, count, 99), max_rt, percentile(tat, count, 99));
+    }
+
+    free(rt);
+    free(tat);
+}
+
+// --- Simulation Entry Point ---
+
+void run_cfs_rt(Process p[], int n) {
+    if (rt_runtime >= 0) {
+        printf("Starting Simulation (CFS with SCHED_FIFO/SCHED_RR above it, RT runtime %d of every %d ticks)...\n",
+               rt_runtime, rt_period);
+    } else {
+        printf("Starting Simulation (CFS with SCHED_FIFO/SCHED_RR above it, RT unthrottled)...\n");
+    }
+
+    SimEngine e;
+    RtCfsRq rq;
+    rq.rt.next = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    rq.rt.slice = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    engine_init(&e, p, n);
+    rt_cfs_engine_run(&e, &rq);
+
+    // Close the last throttled stretch at the end of the run
+    rt_update_period(&rq.rt, e.now);
+    if (rq.rt.throttled) rq.rt.throttled_time += e.now - rq.rt.throttled_at;
+
+    print_table(p, n, "CFS + RT Classes");
+    rt_print_class_table(p, n);
+
+    printf("\n");
+    if (rt_runtime >= 0) {
+        printf("RT Bandwidth               = %d of every %d ticks\n", rt_runtime, rt_period);
+    } else {
+        printf("RT Bandwidth               = unlimited\n");
+    }
+    printf("RT Throttled               = %ld ticks in %d windows\n",
+           rq.rt.throttled_time, rq.rt.throttle_count);
+    printf("SCHED_RR Timeslice         = %d ticks\n", rt_timeslice);
+}
@@ -0,0 +1,70 @@
+#ifndef RT_H
+#define RT_H
+
+#include "common.h"
+
+// --- Real-Time Classes Stacked Above CFS ---
+// Each process declares a policy. SCHED_FIFO and SCHED_RR tasks (POLICY_FIFO,
+// POLICY_RR) always run ahead of CFS tasks: a waking RT task preempts any CFS
+// task at once and a lower RT priority at once. FIFO runs until it blocks,
+// exits or is preempted; RR additionally rotates among equal priorities
+// every rt_timeslice ticks. A preempted RT task keeps its place at the head
+// of its priority list.
+//
+// RT bandwidth (sched_rt_runtime_us / sched_rt_period_us): in every window
+// of rt_period ticks the RT tasks together may run for rt_runtime ticks.
+// Past that the RT class is throttled until the next window and CFS tasks,
+// or nobody, get the CPU. rt_runtime < 0 disables throttling.
+
+#define POLICY_NORMAL 0
+#define POLICY_FIFO   1
+#define POLICY_RR     2
+
+#define RT_MAX_PRIO 100          // Valid RT priorities are 1..99
+
+#define RT_DEFAULT_PERIOD   100  // Ticks (kernel: 1 s)
+#define RT_DEFAULT_RUNTIME  95   // Ticks (kernel: 0.95 s)
+#define RT_DEFAULT_TIMESLICE 5   // SCHED_RR quantum in ticks (kernel: 100 ms)
+
+// --- RT Runqueue ---
+// One FIFO list per priority, linked through task indices, plus a bitmap of
+// non-empty lists so the highest priority is found without scanning them.
+#define RT_BITMAP_WORDS ((RT_MAX_PRIO + 31) / 32)
+
+typedef struct {
+    int *next;                      // Per task: next index in its list, -1 = last
+    int head[RT_MAX_PRIO];
+    int tail[RT_MAX_PRIO];
+    uint32_t bitmap[RT_BITMAP_WORDS];
+    int nr_queued;                  // Queued RT tasks (running one excluded)
+
+    Process *curr;                  // Running RT task
+    bool requeue_tail;              // curr used up its SCHED_RR quantum
+    int *slice;                     // SCHED_RR: ticks left of each task's quantum
+
+    int period_end;                 // End of the current bandwidth window
+    int rt_time;                    // RT ticks used in this window
+    bool throttled;
+    int throttled_at;
+    long throttled_time;            // Ticks the RT class spent throttled
+    int throttle_count;             // Windows in which it was throttled
+} RtRq;
+
+// 'next' and 'slice' are supplied by the caller (n entries each) and may be
+// shared by several runqueues, since a task is queued on at most one.
+void rt_rq_init(RtRq *rq, int n);
+void rt_push(RtRq *rq, Process p[], int idx, bool at_head);
+int rt_pop_highest(RtRq *rq);                   // Task index; the queue must not be empty
+int rt_top_prio(const RtRq *rq);                // Highest queued priority, 0 = empty
+
+// Set once by main.c
+extern int rt_period;
+extern int rt_runtime;
+extern int rt_timeslice;
+
+void run_cfs_rt(Process p[], int n);
+
+// Per-policy CPU, wait, turnaround and response (average, P99) table
+void rt_print_class_table(Process p[], int n);
+
+#endif
@@ -1,73 +1,56 @@
 #include "sjf.h"
+#include "Engine/engine.h"
+#include "IO/io.h"
 
-void run_sjf(Process p[], int n) {
-    printf("Starting Simulation (SRTF - Preemptive SJF)...\n");
-    reset_processes(p, n);
-    
-    int current_time = 0;
-    int completed = 0;
-    
-    // Gantt tracking
-    int last_pid = -1;
-    int gantt_start = 0;
-    
-    while(completed != n) {
-        int idx = -1;
-        int min_rem = 100000;
+// --- SRTF Scheduling Class ---
+// Re-picked every tick, so a shorter arrival preempts immediately.
 
-        // Find process with shortest remaining time that has arrived
-        for(int i=0; i<n; i++) {
-            if(p[i].at <= current_time && !p[i].completed) {
-                if(p[i].rem_bt < min_rem) {
-                    min_rem = p[i].rem_bt;
-                    idx = i;
-                }
-                // Tie-breaker: Arrival time
-                else if(p[i].rem_bt == min_rem) {
-                    if(p[i].at < p[idx].at) {
-                        idx = i;
-                    }
-                }
-            }
-        }
+typedef struct {
+    int unused;
+} SjfRq;
 
-        if(idx != -1) {
-            // Check for context switch
-            if(last_pid != p[idx].pid && last_pid != -1) {
-                add_gantt_event(last_pid, gantt_start, current_time);
-                gantt_start = current_time;
-            } else if(last_pid == -1) {
-                gantt_start = current_time;
-            }
-            last_pid = p[idx].pid;
-            
-            if(!p[idx].started) {
-                p[idx].start_time = current_time;
-                p[idx].rt = current_time - p[idx].at;
-                p[idx].started = true;
-            }
-            
-            p[idx].rem_bt--;
-            current_time++;
+static void sjf_init(SjfRq *rq, SimEngine *e) {
+    (void)rq; (void)e;
+}
+
+// Process with shortest remaining time that has arrived
+static Process* sjf_pick_next(SjfRq *rq, SimEngine *e) {
+    (void)rq;
+    Process *p = e->p;
+    int idx = -1;
+    int min_rem = 100000;
 
-            if(p[idx].rem_bt == 0) {
-                add_gantt_event(p[idx].pid, gantt_start, current_time);
-                last_pid = -1;
-                
-                p[idx].ct = current_time;
-                p[idx].tat = p[idx].ct - p[idx].at;
-                p[idx].wt = p[idx].tat - p[idx].bt;
-                p[idx].completed = true;
-                completed++;
+    for(int i=0; i<e->n; i++) {
+        if(p[i].at <= e->now && !p[i].completed && !p[i].blocked) {
+            // Remaining time of the current CPU burst (== rem_bt without I/O)
+            int rem = io_cpu_left(&p[i]);
+            if(rem < min_rem) {
+                min_rem = rem;
+                idx = i;
             }
-        } else {
-            if(last_pid != -1) {
-                add_gantt_event(last_pid, gantt_start, current_time);
-                last_pid = -1;
+            // Tie-breaker: Arrival time
+            else if(rem == min_rem) {
+                if(p[i].at < p[idx].at) {
+                    idx = i;
+                }
             }
-            current_time++;
         }
     }
-    print_table(p, n, "SRTF (Preemptive SJF)");
+    return (idx == -1) ? NULL : &p[idx];
 }
 
+#define SCHED_CLASS sjf
+#define SCHED_RQ SjfRq
+#define SCHED_PER_TICK
+#include "Engine/engine_loop.h"
+
+void run_sjf(Process p[], int n) {
+    if (!sim_quiet) printf("Starting Simulation (SRTF - Preemptive SJF)...\n");
+
+    SimEngine e;
+    SjfRq rq;
+    engine_init(&e, p, n);
+    sjf_engine_run(&e, &rq);
+
+    print_table(p, n, "SRTF (Preemptive SJF)");
+}
@@ -0,0 +1,1188 @@
+#include <math.h>
+#include <string.h>
+#include <limits.h>
+#include "smp.h"
+#include "CFS/cfs.h"
+#include "RT/rt.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "Engine/engine.h"
+#include "Arena/arena.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#define SMP_THREADS 1
+#endif
+
+// Kernel fits_capacity(): util must leave 20% of the capacity spare
+#define fits_capacity(util, cap) ((util) * 1280 < (double)(cap) * 1024)
+
+// --- Per-Task and Per-CPU State ---
+
+typedef struct {
+    int cpu;              // CPU it is queued on, runs on or last ran on; -1 = not placed yet
+    int last_cpu;         // CPU it last made progress on, -1 = never ran
+    double util;          // Capacity-invariant utilization, 0..SCHED_CAPACITY_SCALE
+    int util_stamp;       // Time 'util' was last brought up to date
+    int work;             // Capacity units done towards the next full-speed tick
+    int exec;             // Ticks on a CPU that made progress
+    int big_exec;         // Those of them on the biggest CPUs
+    int migrations;       // Times it resumed on a different CPU than it last ran on
+    int home;             // Node holding its memory (first touch), -1 = not yet
+    int remote;           // Progress ticks on a node other than 'home'
+} SmpTask;
+
+// A log or trace call held back while CPUs run on other threads
+#define EVENT_SLICE    0  // Gantt segment and trace slice (cpu_gantt_close)
+#define EVENT_VRUNTIME 1  // add_vruntime_log
+
+// Where in a tick it happened: picks of every CPU come before the ticks
+#define PHASE_PICK 0
+#define PHASE_TICK 1
+
+// At most one slice at the pick, one vruntime record and one slice in the tick
+#define EVENTS_PER_TICK 3
+
+typedef struct {
+    int tick;
+    signed char phase;
+    signed char kind;
+    int pid;
+    int start;            // Slice start; EVENT_VRUNTIME: the tick logged
+    int end;
+    int reason;
+    int64_t vruntime;
+} SmpEvent;
+
+typedef struct {
+    int id;
+    int capacity;
+    int max_speed;        // Most work a tick can do here, for the window lookahead
+    Process *curr;        // Running task (RT or CFS), NULL = idle
+    bool need_resched;
+    int resched_reason;   // TRACE_END_* of the slice a pending resched ends
+    int stall;            // Switch/cache overhead ticks left before curr progresses
+    Process *cache;       // Task whose working set is in this CPU's cache
+
+    int gantt_pid;        // Open Gantt segment, -1 = none
+    int gantt_start;
+
+    // CFS: waiting tasks, the running one is not in the tree
+    Node *root;
+    long load;            // Weight of waiting + running CFS tasks
+    int64_t min_vruntime; // Monotonic floor for tasks placed on this CPU
+    double slice_rem;
+
+    RtRq rt;              // Waiting RT tasks; rt.curr is the running one
+
+    long busy;            // Ticks running a task or paying switch overhead
+    long work;            // Capacity units of work done
+
+    // Counted per CPU so parallel windows share nothing; summed for the report
+    long level_migrations[TOPO_LEVELS];
+    long level_cost[TOPO_LEVELS];
+    long remote_loss;
+
+    // Parallel windows: events held back for the coordinator, in order
+    bool deferred;
+    int ev_tick;
+    int ev_phase;
+    SmpEvent *outbox;
+    int outbox_count;
+} SmpCpu;
+
+#ifdef SMP_THREADS
+// Sense-reversing spin barrier; windows are short, so waiting threads spin
+// (yielding after a while) instead of sleeping on a condition variable
+typedef struct {
+    int count;
+    int waiting;
+    int sense;
+} SpinBarrier;
+#endif
+
+typedef struct {
+    SimEngine e;          // Arrivals and completion count; e.now = current tick
+    SmpTask *task;
+    SmpCpu cpu[SMP_MAX_CPUS];
+    int nr_cpus;
+    int max_capacity;
+    int balance_interval;
+    double util_decay;    // Per-tick factor, halves util every SMP_UTIL_HALFLIFE ticks
+
+    const SmpConfig *cfg;
+    signed char level[SMP_MAX_CPUS][SMP_MAX_CPUS]; // smp_topo_level of every CPU pair
+    bool level_used[TOPO_LEVELS];                  // Some pair of CPUs meets at this level
+    bool sibling_busy[SMP_MAX_CPUS];               // Snapshot for SMT contention in a tick
+
+    long misfit_migrations;
+    long balance_migrations;
+    long rt_pushes;
+    long level_migrations[TOPO_LEVELS];
+    long level_cost[TOPO_LEVELS];                  // Migration penalty charged, full-speed ticks
+    long remote_loss;                              // Capacity units lost to remote memory
+    int departed;                                  // Tasks that completed or blocked in the last tick
+
+    // Parallel windows (--pdes)
+    int window_from, window_to;                    // Ticks the groups run next
+    bool window_stop;                              // Workers exit at the next barrier
+    long windows;
+    long window_ticks;                             // Ticks run in windows
+    long serial_ticks;                             // Ticks run by smp_step
+#ifdef SMP_THREADS
+    SpinBarrier barrier;
+    int cpu_split;                                 // CPUs 0..cpu_split-1 run on the coordinator
+#endif
+} SmpSched;
+
+static bool is_rt(const Process *x) {
+    return x->policy != POLICY_NORMAL;
+}
+
+static SmpTask* task_of(SmpSched *s, Process *x) {
+    return &s->task[x - s->e.p];
+}
+
+// Decays util over the ticks since it was last updated
+static void util_update(SmpSched *s, SmpTask *t, int now) {
+    if (now <= t->util_stamp) return;
+    t->util *= pow(s->util_decay, now - t->util_stamp);
+    t->util_stamp = now;
+}
+
+static bool task_fits(SmpSched *s, Process *x, int capacity) {
+    SmpTask *t = task_of(s, x);
+    util_update(s, t, s->e.now);
+    return fits_capacity(t->util, capacity);
+}
+
+static bool cpu_idle(const SmpCpu *c) {
+    return c->curr == NULL && c->root == NULL && c->rt.nr_queued == 0;
+}
+
+// Highest priority a CPU runs or has waiting: -1 idle, 0 CFS, else the RT priority
+static int cpu_prio(const SmpCpu *c) {
+    int prio = rt_top_prio(&c->rt);
+    if (c->curr != NULL && is_rt(c->curr) && c->curr->rt_priority > prio) prio = c->curr->rt_priority;
+    if (prio > 0) return prio;
+    return cpu_idle(c) ? -1 : 0;
+}
+
+// Runnable weight per unit of capacity; RT tasks count as nice-0 tasks
+static double cpu_load(const SmpCpu *c, long extra) {
+    long rt_tasks = c->rt.nr_queued + ((c->curr != NULL && is_rt(c->curr)) ? 1 : 0);
+    return (double)(c->load + extra + rt_tasks * BASE_WEIGHT) / c->capacity;
+}
+
+// Topology distance from 'prev' for tie-breaks: same CPU first, unknown last
+static int nearness(const SmpSched *s, int prev, const SmpCpu *c) {
+    return (prev >= 0) ? s->level[prev][c->id] : TOPO_LEVELS;
+}
+
+// Keeps min_vruntime at the smallest vruntime on the CPU, never moving back
+static void update_min_vruntime(SmpCpu *c) {
+    bool any = false;
+    int64_t v = 0;
+    if (c->curr != NULL && !is_rt(c->curr)) {
+        v = c->curr->vruntime;
+        any = true;
+    }
+    if (c->root != NULL) {
+        int64_t left = minValueNode(c->root)->process->vruntime;
+        if (!any || left < v) v = left;
+        any = true;
+    }
+    if (any && v > c->min_vruntime) c->min_vruntime = v;
+}
+
+// --- Gantt and Dispatch Bookkeeping ---
+
+static void record_slice(int cpu, int pid, int start, int end, int reason) {
+    if (end > start) add_gantt_event(pid, start, end);
+    trace_slice(cpu, pid, start, end, reason);
+}
+
+static SmpEvent* outbox_push(SmpCpu *c, int kind) {
+    SmpEvent *ev = &c->outbox[c->outbox_count++];
+    ev->tick = c->ev_tick;
+    ev->phase = (signed char)c->ev_phase;
+    ev->kind = (signed char)kind;
+    return ev;
+}
+
+static void cpu_gantt_close(SmpCpu *c, int end, int reason) {
+    if (c->gantt_pid == -1) return;
+    if (c->deferred) {
+        SmpEvent *ev = outbox_push(c, EVENT_SLICE);
+        ev->pid = c->gantt_pid;
+        ev->start = c->gantt_start;
+        ev->end = end;
+        ev->reason = reason;
+    } else {
+        record_slice(c->id, c->gantt_pid, c->gantt_start, end, reason);
+    }
+    c->gantt_pid = -1;
+}
+
+static void cpu_dispatched(SmpCpu *c, Process *x, int at) {
+    if (c->gantt_pid == -1) {
+        c->gantt_pid = x->pid;
+        c->gantt_start = at;
+    }
+    if (!x->started) {
+        x->start_time = at;
+        x->rt = at - x->at;
+        x->started = true;
+    }
+    io_note_dispatch(x, at);
+}
+
+// --- Enqueue and Dequeue ---
+
+static void enqueue_task(SmpSched *s, SmpCpu *c, Process *x, int flags) {
+    SmpTask *t = task_of(s, x);
+
+    // vruntime is relative to the CPU's min_vruntime, so it moves with the task
+    if (t->cpu >= 0 && t->cpu != c->id && !is_rt(x)) {
+        x->vruntime += c->min_vruntime - s->cpu[t->cpu].min_vruntime;
+    }
+    t->cpu = c->id;
+
+    if (is_rt(x)) {
+        rt_push(&c->rt, s->e.p, (int)(x - s->e.p), false);
+        // A waking RT task preempts CFS and lower RT priorities at once
+        if (c->curr != NULL && (!is_rt(c->curr) || x->rt_priority > c->curr->rt_priority)) {
+            c->need_resched = true;
+            c->resched_reason = TRACE_END_PREEMPT;
+        }
+        return;
+    }
+
+    if (flags == ENQUEUE_ARRIVAL) {
+        x->vruntime = c->min_vruntime;
+    } else {
+        // Sleeper credit of at most half a latency period, as in CFS/
+        int64_t floor_vruntime = c->min_vruntime - sched_latency * VRUNTIME_SCALE / 2;
+        if (x->vruntime < floor_vruntime) x->vruntime = floor_vruntime;
+    }
+    c->root = insert(c->root, x);
+    c->load += x->weight;
+}
+
+// The running task leaves the CPU: exit, sleep or migration
+static void put_curr_off(SmpCpu *c, int now, int reason) {
+    Process *x = c->curr;
+    cpu_gantt_close(c, now, reason);
+    if (is_rt(x)) {
+        c->rt.curr = NULL;
+        c->rt.requeue_tail = false;
+    } else {
+        c->load -= x->weight;
+    }
+    c->curr = NULL;
+    c->stall = 0;
+}
+
+// Leftmost waiting CFS task of 'src' moves to 'dst'
+static void migrate_waiting_cfs(SmpSched *s, SmpCpu *src, SmpCpu *dst) {
+    Process *x = minValueNode(src->root)->process;
+    src->root = deleteNode(src->root, x);
+    src->load -= x->weight;
+    enqueue_task(s, dst, x, ENQUEUE_WAKEUP);
+}
+
+// --- CPU Selection ---
+
+static SmpCpu* select_cpu_fair(SmpSched *s, Process *x) {
+    SmpTask *t = task_of(s, x);
+    SmpCpu *best = NULL;
+
+    // 1. An idle CPU the task fits on: the one it last ran on (warm cache),
+    //    else the smallest, keeping big CPUs free for big tasks
+    if (t->cpu >= 0 && cpu_idle(&s->cpu[t->cpu]) && task_fits(s, x, s->cpu[t->cpu].capacity)) {
+        return &s->cpu[t->cpu];
+    }
+    // Ties go to the CPU nearest the previous one in the topology
+    int prev = t->cpu;
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        if (!cpu_idle(c) || !task_fits(s, x, c->capacity)) continue;
+        if (best == NULL || c->capacity < best->capacity ||
+            (c->capacity == best->capacity && nearness(s, prev, c) < nearness(s, prev, best))) best = c;
+    }
+    if (best != NULL) return best;
+
+    // 2. Too big for every idle CPU: the biggest idle one
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        if (!cpu_idle(c)) continue;
+        if (best == NULL || c->capacity > best->capacity ||
+            (c->capacity == best->capacity && nearness(s, prev, c) < nearness(s, prev, best))) best = c;
+    }
+    if (best != NULL) return best;
+
+    // 3. All busy: least load per capacity, among CPUs it fits on first
+    for (int pass = 0; pass < 2 && best == NULL; pass++) {
+        double best_load = 0;
+        for (int i = 0; i < s->nr_cpus; i++) {
+            SmpCpu *c = &s->cpu[i];
+            if (pass == 0 && !task_fits(s, x, c->capacity)) continue;
+            double load = cpu_load(c, x->weight);
+            if (best == NULL || load < best_load ||
+                (load == best_load && nearness(s, prev, c) < nearness(s, prev, best))) {
+                best = c;
+                best_load = load;
+            }
+        }
+    }
+    return best;
+}
+
+// Is CPU 'c' at priority 'prio' a better RT target than 'best' at 'best_prio'?
+static bool rt_target_better(const SmpSched *s, const SmpCpu *c, int prio,
+                             const SmpCpu *best, int best_prio, int prev) {
+    if (best == NULL || prio != best_prio) return best == NULL || prio < best_prio;
+    if (c->capacity != best->capacity) return c->capacity > best->capacity;
+    return nearness(s, prev, c) < nearness(s, prev, best);
+}
+
+// The CPU running the lowest-priority work, biggest first (RT tasks are
+// treated as needing full capacity, like the kernel's default uclamp)
+static SmpCpu* select_cpu_rt(SmpSched *s, Process *x) {
+    int prev = task_of(s, x)->cpu;
+    SmpCpu *best = NULL;
+    int best_prio = 0;
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        int prio = cpu_prio(c);
+        if (rt_target_better(s, c, prio, best, best_prio, prev)) {
+            best = c;
+            best_prio = prio;
+        }
+    }
+    return best;
+}
+
+static void wake_task(SmpSched *s, Process *x, int flags) {
+    SmpCpu *c = is_rt(x) ? select_cpu_rt(s, x) : select_cpu_fair(s, x);
+    enqueue_task(s, c, x, flags);
+}
+
+// --- Pick ---
+
+static void cpu_pick(SmpSched *s, SmpCpu *c, int now) {
+    // A switch in progress completes before the next one, as on one CPU
+    if (c->curr != NULL && (!c->need_resched || c->stall > 0)) return;
+
+    Process *prev = c->curr;
+    c->need_resched = false;
+
+    // A preempted RT task keeps its place, an expired RR quantum goes last
+    bool requeue_cfs = false;
+    if (prev != NULL) {
+        if (is_rt(prev)) {
+            rt_push(&c->rt, s->e.p, (int)(prev - s->e.p), !c->rt.requeue_tail);
+            c->rt.curr = NULL;
+            c->rt.requeue_tail = false;
+        } else {
+            requeue_cfs = true;
+        }
+    }
+
+    // RT first, then the leftmost CFS task, prev included. The leftmost
+    // leaves the tree before prev goes back in, so prev reuses its node:
+    // picks inside a parallel window never allocate.
+    Process *next = NULL;
+    if (c->rt.nr_queued > 0) {
+        next = &s->e.p[rt_pop_highest(&c->rt)];
+        c->rt.curr = next;
+        if (requeue_cfs) c->root = insert(c->root, prev);
+    } else if (c->root != NULL) {
+        Process *left = minValueNode(c->root)->process;
+        if (requeue_cfs && entity_before(prev, left)) {
+            next = prev;
+        } else {
+            next = left;
+            c->root = deleteNode(c->root, next);
+            if (requeue_cfs) c->root = insert(c->root, prev);
+        }
+    } else if (requeue_cfs) {
+        next = prev;
+    }
+
+    if (next != prev) {
+        cpu_gantt_close(c, now, c->resched_reason);
+        c->curr = next;
+        c->stall = 0;
+        if (next != NULL) {
+            // Migrated: only an SMT sibling shares the task's cached working
+            // set, and the move itself costs the level's migrate_cost
+            SmpTask *t = task_of(s, next);
+            int penalty = 0;
+            if (t->last_cpu >= 0 && t->last_cpu != c->id) {
+                int level = s->level[t->last_cpu][c->id];
+                if (level != TOPO_SMT) next->last_ran = -1;
+                penalty = s->cfg->migrate_cost[level];
+                t->migrations++;
+                c->level_migrations[level]++;
+                c->level_cost[level] += penalty;
+            }
+
+            // Overhead is work too: a slower CPU takes longer to switch
+            cs_swap_owner(c->cache);
+            int overhead = cs_dispatch(next, now) + penalty;
+            c->stall = (overhead * SCHED_CAPACITY_SCALE + c->capacity - 1) / c->capacity;
+            c->cache = next;
+
+            if (!is_rt(next)) {
+                double slice = sched_latency * (1.0 * next->weight / c->load);
+                if (slice < sched_min_granularity) slice = sched_min_granularity;
+                c->slice_rem = slice;
+            }
+        }
+    }
+    if (next != NULL) cpu_dispatched(c, next, now + c->stall);
+}
+
+// --- Balancing ---
+
+// Queued RT tasks that cannot run where they are go to a CPU running
+// lower-priority work
+static void push_rt_tasks(SmpSched *s) {
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        while (c->rt.nr_queued > 0) {
+            int prio = rt_top_prio(&c->rt);
+            SmpCpu *dst = NULL;
+            int dst_prio = 0;
+            for (int j = 0; j < s->nr_cpus; j++) {
+                SmpCpu *d = &s->cpu[j];
+                int d_prio = cpu_prio(d);
+                if (d == c || d_prio >= prio) continue;
+                if (rt_target_better(s, d, d_prio, dst, dst_prio, i)) {
+                    dst = d;
+                    dst_prio = d_prio;
+                }
+            }
+            if (dst == NULL) break;
+
+            enqueue_task(s, dst, &s->e.p[rt_pop_highest(&c->rt)], ENQUEUE_WAKEUP);
+            s->rt_pushes++;
+        }
+    }
+}
+
+// A CFS task waits behind another one on this CPU (an idle CPU's queue
+// is about to run)
+static bool has_waiting_cfs(const SmpCpu *c) {
+    return c->root != NULL && c->curr != NULL;
+}
+
+// Idle CPUs pull the longest-waiting CFS task of the most loaded CPU in
+// the nearest domain that has one. Across nodes the task would run on
+// remote memory, so only a CPU with a backlog (two or more waiting) gives
+// one up.
+static void idle_pull(SmpSched *s) {
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *d = &s->cpu[i];
+        if (!cpu_idle(d)) continue;
+
+        SmpCpu *src = NULL;
+        for (int level = TOPO_SMT; level < TOPO_LEVELS && src == NULL; level++) {
+            for (int j = 0; j < s->nr_cpus; j++) {
+                SmpCpu *c = &s->cpu[j];
+                if (s->level[i][j] != level || !has_waiting_cfs(c)) continue;
+                if (level == TOPO_NUMA && c->root->height < 2) continue; // Single node = single waiter
+                if (src == NULL || cpu_load(c, 0) > cpu_load(src, 0)) src = c;
+            }
+        }
+        if (src == NULL) continue;
+
+        migrate_waiting_cfs(s, src, d);
+        s->balance_migrations++;
+    }
+}
+
+// Is idle CPU 'd' a better home for misfit task 'x' than 'best'? Smallest
+// CPU it fits on, else the biggest, then the nearest to where it runs.
+static bool misfit_target_better(SmpSched *s, Process *x, const SmpCpu *from,
+                                 const SmpCpu *d, const SmpCpu *best) {
+    if (best == NULL) return true;
+    bool fits = task_fits(s, x, d->capacity);
+    bool best_fits = task_fits(s, x, best->capacity);
+    if (fits != best_fits) return fits;
+    if (d->capacity != best->capacity) return fits ? d->capacity < best->capacity : d->capacity > best->capacity;
+    return s->level[from->id][d->id] < s->level[from->id][best->id];
+}
+
+// Running CFS tasks that outgrew their CPU move to an idle bigger one
+static void misfit_migration(SmpSched *s, int now) {
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        Process *x = c->curr;
+        if (x == NULL || is_rt(x) || c->stall > 0 || c->capacity == s->max_capacity) continue;
+        if (task_fits(s, x, c->capacity)) continue;
+
+        SmpCpu *dst = NULL;
+        for (int j = 0; j < s->nr_cpus; j++) {
+            SmpCpu *d = &s->cpu[j];
+            if (!cpu_idle(d) || d->capacity <= c->capacity) continue;
+            if (misfit_target_better(s, x, c, d, dst)) dst = d;
+        }
+        if (dst == NULL) continue;
+
+        put_curr_off(c, now, TRACE_END_MIGRATE);
+        enqueue_task(s, dst, x, ENQUEUE_WAKEUP);
+        s->misfit_migrations++;
+    }
+}
+
+// Within the domain of 'leader' at 'level': one waiting task moves from the
+// most to the least loaded CPU (per unit of capacity) if that narrows the
+// gap by more than the domain's imbalance margin
+static void balance_domain(SmpSched *s, int leader, int level) {
+    int pct = (level == TOPO_NUMA) ? SMP_NUMA_IMBALANCE_PCT : 100;
+    SmpCpu *busiest = NULL;
+    SmpCpu *idlest = NULL;
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        if (s->level[leader][i] > level) continue;
+        if (has_waiting_cfs(c) && (busiest == NULL || cpu_load(c, 0) > cpu_load(busiest, 0))) busiest = c;
+    }
+    if (busiest == NULL) return;
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        if (s->level[leader][i] > level) continue;
+        if (c != busiest && (idlest == NULL || cpu_load(c, 0) < cpu_load(idlest, 0))) idlest = c;
+    }
+    if (idlest == NULL) return;
+
+    long w = minValueNode(busiest->root)->process->weight;
+    if (cpu_load(busiest, -w) * 100 <= cpu_load(idlest, w) * pct) return;
+
+    migrate_waiting_cfs(s, busiest, idlest);
+    s->balance_migrations++;
+}
+
+// Sched domains, nearest first: each level that actually groups CPUs
+// balances within every one of its domains, across nodes less often
+static void periodic_balance(SmpSched *s, int now) {
+    for (int level = TOPO_SMT; level < TOPO_LEVELS; level++) {
+        if (!s->level_used[level]) continue;
+        int interval = s->balance_interval * ((level == TOPO_NUMA) ? SMP_NUMA_BALANCE_SCALE : 1);
+        if (now % interval != 0) continue;
+
+        // One pass per domain, led by its lowest-numbered CPU
+        for (int i = 0; i < s->nr_cpus; i++) {
+            bool leader = true;
+            for (int j = 0; j < i && leader; j++) {
+                if (s->level[i][j] <= level) leader = false;
+            }
+            if (leader) balance_domain(s, i, level);
+        }
+    }
+}
+
+// --- Tick ---
+
+static void cpu_tick(SmpSched *s, SmpCpu *c, int now) {
+    Process *x = c->curr;
+    if (x == NULL) return;
+
+    c->busy++;
+    if (c->stall > 0) {
+        c->stall--; // Switch overhead: busy, but no progress
+        return;
+    }
+
+    // Progress scales with capacity: a full-speed tick of burst every
+    // SCHED_CAPACITY_SCALE units of work
+    SmpTask *t = task_of(s, x);
+    util_update(s, t, now);
+    t->util = t->util * s->util_decay + c->capacity * (1.0 - s->util_decay);
+    t->util_stamp = now + 1;
+    t->exec++;
+    if (c->capacity == s->max_capacity) t->big_exec++;
+    t->last_cpu = c->id;
+
+    // A busy SMT sibling shares the core; memory on another node is slower
+    const SmpConfig *cfg = s->cfg;
+    int node = cfg->node[c->id];
+    int speed = c->capacity;
+    if (s->sibling_busy[c->id]) speed = speed * cfg->smt_speed / 100;
+    if (t->home == -1) t->home = node;
+    if (node != t->home) {
+        int remote_speed = speed * cfg->distance[t->home][t->home] / cfg->distance[node][t->home];
+        c->remote_loss += speed - remote_speed;
+        speed = (remote_speed > 0) ? remote_speed : 1;
+        t->remote++;
+    }
+    c->work += speed;
+
+    bool progressed = false;
+    t->work += speed;
+    if (t->work >= SCHED_CAPACITY_SCALE) {
+        t->work -= SCHED_CAPACITY_SCALE;
+        x->rem_bt--;
+        progressed = true;
+    }
+
+    // vruntime charges wall time, so fairness is in time on a CPU
+    if (!is_rt(x)) {
+        x->vruntime += calc_delta_fair(VRUNTIME_SCALE, x);
+        if (c->deferred) {
+            SmpEvent *ev = outbox_push(c, EVENT_VRUNTIME);
+            ev->pid = x->pid;
+            ev->start = now;
+            ev->vruntime = x->vruntime;
+        } else {
+            add_vruntime_log(now, x->pid, x->vruntime);
+        }
+    }
+
+    int end = now + 1;
+    if (x->rem_bt == 0) {
+        x->ct = end;
+        x->tat = x->ct - x->at;
+        x->wt = x->tat - t->exec - x->io_time;
+        x->completed = true;
+        s->e.completed++;
+        s->departed++;
+        trace_lifetime(x);
+        put_curr_off(c, end, TRACE_END_EXIT);
+    } else if (progressed && io_block(x, end)) {
+        s->departed++;
+        put_curr_off(c, end, TRACE_END_SLEEP);
+    } else if (x->policy == POLICY_RR) {
+        // SCHED_RR: rotate among equal priorities once the quantum is used up
+        int *slice = &c->rt.slice[x - s->e.p];
+        if (--*slice <= 0) {
+            *slice = rt_timeslice;
+            if (c->rt.head[x->rt_priority] != -1) {
+                c->rt.requeue_tail = true;
+                cpu_gantt_close(c, end, TRACE_END_YIELD);
+                c->need_resched = true;
+            }
+        }
+    } else if (!is_rt(x)) {
+        c->slice_rem--;
+        if (c->slice_rem <= 0) {
+            if (c->root != NULL && minValueNode(c->root)->process->vruntime < x->vruntime) {
+                c->need_resched = true;
+                c->resched_reason = TRACE_END_RESCHED;
+            } else {
+                c->slice_rem = (c->root != NULL) ? sched_min_granularity : sched_latency;
+            }
+        }
+    }
+    update_min_vruntime(c);
+}
+
+// --- Simulation Loop ---
+
+// Returns false if every CPU was idle and time skipped ahead
+static bool smp_step(SmpSched *s) {
+    int now = s->e.now;
+    Process *x;
+
+    // A. Arrivals, then I/O wakeups, each placed on a CPU
+    int arrived = engine_admit(&s->e);
+    for (int k = 0; k < arrived; k++) wake_task(s, &s->e.p[s->e.batch[k]], ENQUEUE_ARRIVAL);
+    while ((x = io_pop_wakeup(now)) != NULL) wake_task(s, x, ENQUEUE_WAKEUP);
+
+    // B. Pick, so that what waits below cannot run where it is
+    for (int i = 0; i < s->nr_cpus; i++) cpu_pick(s, &s->cpu[i], now);
+
+    // C. Balance, then pick again where work moved
+    push_rt_tasks(s);
+    if (now % s->balance_interval == 0) misfit_migration(s, now);
+    periodic_balance(s, now);
+    idle_pull(s);
+
+    bool any = false;
+    for (int i = 0; i < s->nr_cpus; i++) {
+        cpu_pick(s, &s->cpu[i], now);
+        if (s->cpu[i].curr != NULL) any = true;
+    }
+
+    // Every CPU idle: skip to the next arrival or wakeup
+    if (!any) {
+        engine_idle(&s->e);
+        return false;
+    }
+
+    // D. Run one tick everywhere, SMT contention as of its start
+    if (s->level_used[TOPO_SMT] && s->cfg->smt_speed < 100) {
+        for (int i = 0; i < s->nr_cpus; i++) {
+            s->sibling_busy[i] = false;
+            for (int j = 0; j < s->nr_cpus; j++) {
+                if (s->level[i][j] == TOPO_SMT && s->cpu[j].curr != NULL) s->sibling_busy[i] = true;
+            }
+        }
+    }
+    s->departed = 0;
+    for (int i = 0; i < s->nr_cpus; i++) cpu_tick(s, &s->cpu[i], now);
+    s->e.now = now + 1;
+    s->serial_ticks++;
+    return true;
+}
+
+// --- Parallel Windows (--pdes) ---
+
+// Capacity units task x needs before it completes or blocks
+static long units_to_leave(SmpSched *s, Process *x) {
+    return (long)io_cpu_left(x) * SCHED_CAPACITY_SCALE - task_of(s, x)->work;
+}
+
+static void tree_units(SmpSched *s, Node *node, long *units) {
+    if (node == NULL) return;
+    long u = units_to_leave(s, node->process);
+    if (u < *units) *units = u;
+    tree_units(s, node->left, units);
+    tree_units(s, node->right, units);
+}
+
+// Ticks before any task on this CPU could complete or block: only one of
+// them progresses per tick, by at most max_speed units
+static int cpu_lookahead(SmpSched *s, SmpCpu *c) {
+    long units = LONG_MAX;
+    if (c->curr != NULL) units = units_to_leave(s, c->curr);
+    tree_units(s, c->root, &units);
+    if (c->rt.nr_queued > 0) {
+        for (int prio = 0; prio < RT_MAX_PRIO; prio++) {
+            for (int i = c->rt.head[prio]; i != -1; i = c->rt.next[i]) {
+                long u = units_to_leave(s, &s->e.p[i]);
+                if (u < units) units = u;
+            }
+        }
+    }
+    if (units == LONG_MAX) return INT_MAX;
+    long ticks = (units + c->max_speed - 1) / c->max_speed;
+    return (ticks < SMP_PDES_MAX_WINDOW) ? (int)ticks : SMP_PDES_MAX_WINDOW;
+}
+
+// Would balancing move nothing in the coming ticks? No queued RT task can
+// preempt another CPU, no idle CPU has anything to pull, and no CPU's next
+// pick changes class. Picks that only swap tasks within one queue keep all
+// of this true, so it holds for a whole window.
+static bool cpus_settled(SmpSched *s) {
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        if (c->rt.nr_queued > 0) {
+            if (c->curr == NULL || !is_rt(c->curr)) return false;
+            int prio = rt_top_prio(&c->rt);
+            for (int j = 0; j < s->nr_cpus; j++) {
+                if (j != i && cpu_prio(&s->cpu[j]) < prio) return false;
+            }
+        }
+        if (!cpu_idle(c)) continue;
+        for (int j = 0; j < s->nr_cpus; j++) {
+            SmpCpu *src = &s->cpu[j];
+            if (!has_waiting_cfs(src)) continue;
+            if (s->level[i][j] == TOPO_NUMA && src->root->height < 2) continue;
+            return false;
+        }
+    }
+    return true;
+}
+
+// First tick after 'from' that must run serially: an arrival, a wakeup, a
+// balancing tick, or one in which some task could complete or block.
+// Returns 'from' if the last tick changed what balancing would see.
+static int window_end(SmpSched *s, int from) {
+    if (s->departed > 0 || !cpus_settled(s)) return from;
+
+    int end = from + SMP_PDES_MAX_WINDOW;
+    int interval = s->balance_interval;
+    int balance = (from + interval - 1) / interval * interval;
+    if (balance < end) end = balance;
+    if (s->e.next_arrival < s->e.n) {
+        int at = s->e.p[s->e.arrivals[s->e.next_arrival]].at;
+        if (at < end) end = at;
+    }
+    int wake = io_next_wakeup();
+    if (wake >= 0 && wake < end) end = wake;
+
+    // Tick from - 1 just ran, so the k-th progress tick is from - 1 + k
+    for (int i = 0; i < s->nr_cpus && end > from; i++) {
+        int k = cpu_lookahead(s, &s->cpu[i]);
+        if (k != INT_MAX && from - 1 + k < end) end = from - 1 + k;
+    }
+    return (end > from) ? end : from;
+}
+
+// CPUs lo..hi-1 through the window, one CPU at a time: nothing they do
+// reaches another CPU. A second pick (after balancing in smp_step) would
+// find nothing to do, and SMT contention stays as the last serial tick saw it.
+static void run_group(SmpSched *s, int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+        SmpCpu *c = &s->cpu[i];
+        for (int now = s->window_from; now < s->window_to; now++) {
+            c->ev_tick = now;
+            c->ev_phase = PHASE_PICK;
+            cpu_pick(s, c, now);
+            c->ev_phase = PHASE_TICK;
+            cpu_tick(s, c, now);
+        }
+    }
+}
+
+// Held-back events in the order the serial engine makes them: by tick,
+// picks before ticks, then by CPU
+static void replay_outboxes(SmpSched *s) {
+    int cursor[SMP_MAX_CPUS] = { 0 };
+    for (int now = s->window_from; now < s->window_to; now++) {
+        for (int phase = PHASE_PICK; phase <= PHASE_TICK; phase++) {
+            for (int i = 0; i < s->nr_cpus; i++) {
+                SmpCpu *c = &s->cpu[i];
+                while (cursor[i] < c->outbox_count && c->outbox[cursor[i]].tick == now &&
+                       c->outbox[cursor[i]].phase == phase) {
+                    const SmpEvent *ev = &c->outbox[cursor[i]++];
+                    if (ev->kind == EVENT_SLICE) record_slice(c->id, ev->pid, ev->start, ev->end, ev->reason);
+                    else add_vruntime_log(ev->start, ev->pid, ev->vruntime);
+                }
+            }
+        }
+    }
+    for (int i = 0; i < s->nr_cpus; i++) s->cpu[i].outbox_count = 0;
+}
+
+#ifdef SMP_THREADS
+static void barrier_wait(SpinBarrier *b, int *sense) {
+    *sense = !*sense;
+    if (__atomic_add_fetch(&b->waiting, 1, __ATOMIC_ACQ_REL) == b->count) {
+        __atomic_store_n(&b->waiting, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&b->sense, *sense, __ATOMIC_RELEASE);
+        return;
+    }
+    int spins = 0;
+    while (__atomic_load_n(&b->sense, __ATOMIC_ACQUIRE) != *sense) {
+        if (++spins > 1000) sched_yield();
+    }
+}
+
+typedef struct {
+    SmpSched *s;
+    int lo, hi;                  // CPUs this host thread owns
+    int sched_latency, sched_min_granularity;
+    long switch_count, switch_overhead, cache_overhead;
+} SmpWorker;
+
+static void* window_worker(void *arg) {
+    SmpWorker *w = (SmpWorker*)arg;
+    SmpSched *s = w->s;
+    int sense = 0;
+    sched_latency = w->sched_latency;
+    sched_min_granularity = w->sched_min_granularity;
+
+    while (1) {
+        barrier_wait(&s->barrier, &sense);
+        if (s->window_stop) break;
+        run_group(s, w->lo, w->hi);
+        barrier_wait(&s->barrier, &sense);
+    }
+
+    // Switch counts are per thread; the coordinator adds them up
+    w->switch_count = cs_switch_count;
+    w->switch_overhead = cs_switch_overhead;
+    w->cache_overhead = cs_cache_overhead;
+    sim_release_thread();
+    return NULL;
+}
+#endif
+
+static void run_window(SmpSched *s, int from, int to, int *sense) {
+    s->window_from = from;
+    s->window_to = to;
+    for (int i = 0; i < s->nr_cpus; i++) s->cpu[i].deferred = true;
+#ifdef SMP_THREADS
+    barrier_wait(&s->barrier, sense);
+    run_group(s, 0, s->cpu_split);
+    barrier_wait(&s->barrier, sense);
+#else
+    (void)sense;
+    run_group(s, 0, s->nr_cpus);
+#endif
+    for (int i = 0; i < s->nr_cpus; i++) s->cpu[i].deferred = false;
+    replay_outboxes(s);
+    s->e.now = to;
+    s->windows++;
+    s->window_ticks += to - from;
+}
+
+// Serial ticks with parallel windows in between, on 'threads' host threads
+static void run_pdes(SmpSched *s, int threads) {
+    int n = s->e.n;
+    int sense = 0;
+#ifdef SMP_THREADS
+    SmpWorker *workers = (SmpWorker*)arena_calloc(&run_arena, threads, sizeof(SmpWorker));
+    pthread_t *ids = (pthread_t*)arena_alloc(&run_arena, threads * sizeof(pthread_t));
+    s->barrier.count = threads;
+    for (int k = 0; k < threads; k++) {
+        workers[k].s = s;
+        workers[k].lo = s->nr_cpus * k / threads;
+        workers[k].hi = s->nr_cpus * (k + 1) / threads;
+        workers[k].sched_latency = sched_latency;
+        workers[k].sched_min_granularity = sched_min_granularity;
+    }
+    s->cpu_split = workers[0].hi;   // The coordinator runs the first group itself
+    for (int k = 1; k < threads; k++) pthread_create(&ids[k], NULL, window_worker, &workers[k]);
+#else
+    (void)threads;
+#endif
+
+    while (s->e.completed < n) {
+        if (!smp_step(s)) continue;
+        int from = s->e.now;
+        int to = window_end(s, from);
+        if (to - from >= SMP_PDES_MIN_WINDOW) run_window(s, from, to, &sense);
+    }
+
+#ifdef SMP_THREADS
+    s->window_stop = true;
+    barrier_wait(&s->barrier, &sense);
+    for (int k = 1; k < threads; k++) {
+        pthread_join(ids[k], NULL);
+        cs_switch_count += workers[k].switch_count;
+        cs_switch_overhead += workers[k].switch_overhead;
+        cs_cache_overhead += workers[k].cache_overhead;
+    }
+#endif
+}
+
+// --- Reporting ---
+
+static int describe_cpus(const SmpSched *s, char *buf, size_t size) {
+    int distinct = 0;
+    size_t len = 0;
+    buf[0] = '\0';
+    for (int cap = s->max_capacity; cap > 0; cap--) {
+        int count = 0;
+        for (int i = 0; i < s->nr_cpus; i++) if (s->cpu[i].capacity == cap) count++;
+        if (count == 0) continue;
+        if (len < size) len += snprintf(buf + len, size - len, "%s%dx%d", distinct ? " + " : "", count, cap);
+        distinct++;
+    }
+    return distinct;
+}
+
+static void print_core_types(SmpSched *s, int span) {
+    long total_work = 0;
+    for (int i = 0; i < s->nr_cpus; i++) total_work += s->cpu[i].work;
+    if (total_work == 0) total_work = 1;
+
+    printf("\n--- Per-Core-Type Utilization ---\n\n");
+    printf("Capacity\tCPUs\tBusy\tUtil %%\tWork\tWork %%\n");
+    for (int cap = s->max_capacity; cap > 0; cap--) {
+        int count = 0;
+        long busy = 0, work = 0;
+        for (int i = 0; i < s->nr_cpus; i++) {
+            if (s->cpu[i].capacity != cap) continue;
+            count++;
+            busy += s->cpu[i].busy;
+            work += s->cpu[i].work;
+        }
+        if (count == 0) continue;
+        // Work in full-speed ticks
+        printf("%d\t%d\t%ld\t%.2f\t%.1f\t%.2f\n", cap, count, busy,
+               100.0 * busy / ((double)count * span),
+               (double)work / SCHED_CAPACITY_SCALE, 100.0 * work / total_work);
+    }
+}
+
+static double print_task_slowdown(SmpSched *s) {
+    Process *p = s->e.p;
+    double total = 0;
+    int counted = 0;
+
+    printf("\n--- Per-Task Slowdown ---\n\n");
+    printf("PID\tBT\tExec\tSlowdown\tBig %%\tRemote %%\tMigr\tStretch\n");
+    for (int i = 0; i < s->e.n; i++) {
+        SmpTask *t = &s->task[i];
+        if (p[i].bt <= 0) continue;
+        // Slowdown: CPU ticks taken vs at full speed; Stretch: TAT vs burst
+        double slowdown = (double)t->exec / p[i].bt;
+        printf("%d\t%d\t%d\t%.2f\t%.2f\t%.2f\t%d\t%.2f\n", p[i].pid, p[i].bt, t->exec, slowdown,
+               t->exec > 0 ? 100.0 * t->big_exec / t->exec : 0.0,
+               t->exec > 0 ? 100.0 * t->remote / t->exec : 0.0, t->migrations,
+               (double)p[i].tat / p[i].bt);
+        total += slowdown;
+        counted++;
+    }
+    return counted > 0 ? total / counted : 0;
+}
+
+static void print_topology_migrations(SmpSched *s) {
+    static const char *names[TOPO_LEVELS] = { "SMT", "LLC", "Node", "Cross-Node" };
+
+    printf("\n--- Migrations by Topology Level ---\n\n");
+    printf("Level\tMigrations\tPenalty\n");
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        if (!s->level_used[l]) continue;
+        printf("%s\t%ld\t%ld\n", names[l], s->level_migrations[l], s->level_cost[l]);
+    }
+}
+
+// Most work one tick can do on CPU c: SMT contention and remote memory
+// normally slow it down, but a topology file may say otherwise
+static int max_speed(const SmpConfig *cfg, int cpu, int capacity) {
+    int best = 1;
+    int smt = capacity * cfg->smt_speed / 100;
+    int node = cfg->node[cpu];
+    int nodes = (cfg->nr_nodes > 0) ? cfg->nr_nodes : 1;
+    for (int pass = 0; pass < 2; pass++) {
+        int speed = pass ? smt : capacity;
+        if (speed > best) best = speed;
+        for (int home = 0; home < nodes; home++) {
+            if (cfg->distance[node][home] <= 0) continue;
+            int remote = speed * cfg->distance[home][home] / cfg->distance[node][home];
+            if (remote > best) best = remote;
+        }
+    }
+    return best;
+}
+
+static void fold_cpu_counters(SmpSched *s) {
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        for (int l = 0; l < TOPO_LEVELS; l++) {
+            s->level_migrations[l] += c->level_migrations[l];
+            s->level_cost[l] += c->level_cost[l];
+        }
+        s->remote_loss += c->remote_loss;
+    }
+}
+
+static int pdes_threads(const SmpConfig *cfg) {
+    int threads = 1;
+#ifdef SMP_THREADS
+    threads = cfg->threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+#endif
+    if (threads > cfg->cpu_count) threads = cfg->cpu_count;
+    return threads;
+}
+
+// --- Simulation Entry Point ---
+
+void run_smp(Process p[], int n, const SmpConfig *cfg) {
+    SmpSched *s = (SmpSched*)arena_calloc(&run_arena, 1, sizeof(SmpSched));
+    s->nr_cpus = cfg->cpu_count;
+    s->balance_interval = (cfg->balance_interval > 0) ? cfg->balance_interval : 1;
+    s->util_decay = pow(0.5, 1.0 / SMP_UTIL_HALFLIFE);
+    s->cfg = cfg;
+    for (int a = 0; a < s->nr_cpus; a++) {
+        for (int b = 0; b < s->nr_cpus; b++) {
+            int level = smp_topo_level(cfg, a, b);
+            s->level[a][b] = (signed char)level;
+            if (level >= 0) s->level_used[level] = true;
+        }
+    }
+
+    // RT list links and SCHED_RR quanta are per task, shared by all CPUs
+    int *rt_next = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    int *rt_slice = (int*)arena_alloc(&run_arena, n * sizeof(int));
+
+    long total_capacity = 0;
+    for (int i = 0; i < s->nr_cpus; i++) {
+        SmpCpu *c = &s->cpu[i];
+        c->id = i;
+        c->capacity = cfg->capacity[i];
+        c->max_speed = max_speed(cfg, i, c->capacity);
+        c->gantt_pid = -1;
+        c->resched_reason = TRACE_END_RESCHED;
+        c->rt.next = rt_next;
+        c->rt.slice = rt_slice;
+        rt_rq_init(&c->rt, n);
+        if (c->capacity > s->max_capacity) s->max_capacity = c->capacity;
+        total_capacity += c->capacity;
+    }
+
+    char desc[256];
+    describe_cpus(s, desc, sizeof(desc));
+    if (cfg->nr_nodes > 1) {
+        printf("Starting Simulation (CFS on %d CPUs: %s, %d NUMA nodes)...\n", s->nr_cpus, desc, cfg->nr_nodes);
+    } else {
+        printf("Starting Simulation (CFS on %d CPUs: %s)...\n", s->nr_cpus, desc);
+    }
+
+    engine_init(&s->e, p, n);
+    s->task = (SmpTask*)arena_calloc(&run_arena, n, sizeof(SmpTask));
+    bool has_rt = false;
+    for (int i = 0; i < n; i++) {
+        set_load_weight(&p[i]);
+        s->task[i].cpu = -1;
+        s->task[i].last_cpu = -1;
+        s->task[i].home = -1;
+        if (is_rt(&p[i])) has_rt = true;
+    }
+
+    // Parallel windows need the whole run: an early-stop hook checks every tick
+    bool pdes = cfg->pdes && sim_stop_hook == NULL;
+    int threads = pdes ? pdes_threads(cfg) : 1;
+    if (pdes) {
+        for (int i = 0; i < s->nr_cpus; i++) {
+            s->cpu[i].outbox = (SmpEvent*)arena_alloc(&run_arena,
+                                                      EVENTS_PER_TICK * SMP_PDES_MAX_WINDOW * sizeof(SmpEvent));
+        }
+        run_pdes(s, threads);
+    } else {
+        while (s->e.completed < n && !sim_should_stop(s->e.now)) {
+            smp_step(s);
+        }
+    }
+    fold_cpu_counters(s);
+
+    // Results count capacity across all CPUs
+    sim_capacity = (double)total_capacity / SCHED_CAPACITY_SCALE;
+    print_table(p, n, "CFS on Heterogeneous CPUs");
+    sim_capacity = 1.0;
+    if (has_rt) rt_print_class_table(p, n);
+
+    int max_ct = 0;
+    int min_at = -1;
+    for (int i = 0; i < n; i++) {
+        if (p[i].ct > max_ct) max_ct = p[i].ct;
+        if (min_at == -1 || p[i].at < min_at) min_at = p[i].at;
+    }
+    int span = (max_ct - min_at > 0) ? max_ct - min_at : 1;
+
+    print_core_types(s, span);
+    double avg_slowdown = print_task_slowdown(s);
+    print_topology_migrations(s);
+
+    long migrations = 0;
+    long penalty = 0;
+    for (int i = 0; i < n; i++) migrations += s->task[i].migrations;
+    for (int l = 0; l < TOPO_LEVELS; l++) penalty += s->level_cost[l];
+
+    // Full-speed ticks lost to migration penalties and remote memory, out
+    // of what all CPUs could have done over the run
+    double remote = (double)s->remote_loss / SCHED_CAPACITY_SCALE;
+    double lost_pct = 100.0 * (penalty + remote) / ((double)total_capacity * span / SCHED_CAPACITY_SCALE);
+
+    printf("\n");
+    printf("CPUs                       = %s (%.2f full-speed CPUs)\n", desc,
+           (double)total_capacity / SCHED_CAPACITY_SCALE);
+    printf("Average Slowdown           = %.2f\n", avg_slowdown);
+    printf("Task Migrations            = %ld\n", migrations);
+    printf("Misfit Migrations          = %ld\n", s->misfit_migrations);
+    printf("Balance Migrations         = %ld\n", s->balance_migrations);
+    printf("RT Pushes                  = %ld\n", s->rt_pushes);
+    printf("Cross-Node Migrations      = %ld\n", s->level_migrations[TOPO_NUMA]);
+    printf("Migration Penalty          = %ld ticks\n", penalty);
+    printf("Remote Memory Loss         = %.1f ticks\n", remote);
+    printf("Throughput Lost            = %.2f%% of capacity\n", lost_pct);
+    if (pdes) {
+        long ticks = s->serial_ticks + s->window_ticks;
+        printf("Host Threads               = %d (%d simulated CPUs each, at most)\n", threads,
+               (s->nr_cpus + threads - 1) / threads);
+        printf("Parallel Windows           = %ld (%.1f ticks on average)\n", s->windows,
+               s->windows ? (double)s->window_ticks / s->windows : 0.0);
+        printf("Parallel Ticks             = %.2f%% of %ld simulated ticks\n",
+               ticks ? 100.0 * s->window_ticks / ticks : 0.0, ticks);
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include "common.h"
+
+// --- Heterogeneous Multi-CPU Scheduling (big.LITTLE) ---
+// Several simulated CPUs run CFS, plus SCHED_FIFO/SCHED_RR tasks (RT/rt.h)
+// above it, each CPU with its own runqueues. A CPU's capacity is the work it
+// completes per tick on the kernel's scale: 1024 = a full-speed (big) core,
+// 512 = a core at half its speed. A task's burst time is measured in
+// full-speed ticks, so the same task takes longer on a little core.
+//
+// Placement follows the kernel's capacity-aware paths:
+//   util      Per-task utilization, a PELT-style moving average (half-life
+//             SMP_UTIL_HALFLIFE ticks) of the capacity it consumed, so it
+//             is comparable across core types.
+//   fits      util leaves 20% headroom on the CPU (util * 1.25 < capacity).
+//   CFS       Wakeups go to an idle CPU the task fits on, the smallest such
+//             one first; otherwise to the biggest idle CPU, otherwise to the
+//             least loaded (load / capacity) CPU, fitting ones first.
+//   RT        Tasks go to the CPU running the lowest priority work (idle,
+//             then CFS, then lower RT priorities), bigger CPUs first, and
+//             queued RT tasks are pushed to such CPUs as soon as one exists.
+//   balance   Idle CPUs pull waiting tasks every tick. Every
+//             balance_interval ticks a running CFS task that no longer fits
+//             its CPU (a misfit) is moved to an idle bigger CPU, and one
+//             waiting task moves off the most loaded CPU if that evens out
+//             load / capacity.
+// RT bandwidth throttling (--rt-runtime) is not applied here.
+//
+// Topology (--topology FILE) groups the CPUs into SMT cores, last-level
+// cache domains and NUMA nodes, nearest level first:
+//   SMT   siblings share a core and all its caches; with smt_speed < 100
+//         each runs at that percentage while the other one is busy
+//   LLC   a task moving between cores keeps only the shared cache
+//   NODE  same memory node, different LLC
+//   NUMA  different node: a task's memory stays on the node it first ran
+//         on (first touch), and on any other node it progresses at
+//         distance[home][home] / distance[node][home] of the CPU's speed
+// A task resuming on another CPU than it last ran on pays migrate_cost of
+// the nearest level both CPUs share, in full-speed ticks, and outside its
+// core its cache is cold. Placement and balancing prefer the nearest CPU:
+// idle CPUs pull from the closest busy domain first (across nodes only
+// from a CPU with two or more waiting tasks), and periodic balancing runs
+// per domain, across nodes SMP_NUMA_BALANCE_SCALE times less often and
+// only past a SMP_NUMA_IMBALANCE_PCT imbalance. Without a topology file
+// every CPU is its own core and all share one LLC and node.
+//
+// Parallel windows (--pdes) run one large simulation on several host
+// threads, each owning a contiguous group of simulated CPUs. It is a
+// conservative parallel discrete-event scheme: after every serial tick the
+// coordinator computes how far the CPUs cannot affect each other, and the
+// groups run that window of ticks independently. A window ends before the
+// next arrival, I/O wakeup or balancing tick, and before any task could
+// complete or block (its remaining CPU burst at the CPU's top speed is the
+// lookahead). Picks within a window can only swap tasks inside one CPU's
+// queues, so placement and balancing would do nothing there. Gantt
+// segments, trace slices and vruntime records produced in a window wait in
+// per-CPU outboxes and are replayed in (tick, phase, CPU) order, so every
+// result, log and trace is identical to the serial engine.
+
+#define SMP_MAX_CPUS 64
+#define SCHED_CAPACITY_SCALE 1024
+#define SMP_UTIL_HALFLIFE 8               // Ticks (kernel PELT: 32 ms)
+#define SMP_DEFAULT_BALANCE_INTERVAL 4    // Ticks between periodic balancing
+#define SMP_MAX_NODES 8
+#define SMP_LOCAL_DISTANCE 10             // SLIT distance of a node to itself
+#define SMP_NUMA_BALANCE_SCALE 4          // Cross-node balancing interval multiplier
+#define SMP_NUMA_IMBALANCE_PCT 125        // Cross-node balancing needs 25% more load
+#define SMP_PDES_MAX_WINDOW 256           // Ticks per parallel window (bounds the outboxes)
+#define SMP_PDES_MIN_WINDOW 2             // Shorter windows run serially
+
+// Topology levels, nearest first
+#define TOPO_SMT   0
+#define TOPO_LLC   1
+#define TOPO_NODE  2
+#define TOPO_NUMA  3
+#define TOPO_LEVELS 4
+
+typedef struct {
+    int cpu_count;
+    int capacity[SMP_MAX_CPUS];           // 1..SCHED_CAPACITY_SCALE
+    int balance_interval;
+
+    // Topology, see smp_load_topology
+    int core[SMP_MAX_CPUS];
+    int llc[SMP_MAX_CPUS];
+    int node[SMP_MAX_CPUS];
+    int nr_nodes;
+    int distance[SMP_MAX_NODES][SMP_MAX_NODES];
+    int migrate_cost[TOPO_LEVELS];        // Full-speed ticks per migration at each level
+    int smt_speed;                        // Percent of capacity while the SMT sibling is busy
+
+    bool pdes;                            // Parallel windows on host threads (see above)
+    int threads;                          // Host threads for pdes, 0 = one per host CPU
+} SmpConfig;
+
+// --- Configuration (topology.c) ---
+
+// Parses "2x1024,4x512" (count x capacity) or "1024,512" (one per CPU),
+// with the flat default topology
+bool smp_parse_cpus(const char *spec, SmpConfig *cfg);
+void smp_flat_topology(SmpConfig *cfg);
+
+// Loads CPUs and topology from a text file, '#' starts a comment:
+//   cpu ID core C llc L node N [capacity CAP]   one line per CPU, IDs 0..n-1
+//   distance NODE D0 D1 ...                     SLIT row (default 10 local, 20 remote)
+//   migrate smt|llc|node|numa TICKS             migration cost per level (default 0)
+//   smt_speed PERCENT                           default 100
+bool smp_load_topology(const char *path, SmpConfig *cfg);
+
+// Level of the nearest domain CPUs a and b share, -1 if a == b
+int smp_topo_level(const SmpConfig *cfg, int a, int b);
+
+void run_smp(Process p[], int n, const SmpConfig *cfg);
+
+#endif
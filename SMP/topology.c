@@ -0,0 +1,172 @@
+#include <string.h>
+#include "smp.h"
+
+static const char *level_names[TOPO_LEVELS] = { "smt", "llc", "node", "numa" };
+
+// --- Defaults ---
+
+// Every CPU its own core, one shared LLC, one node, free migrations
+void smp_flat_topology(SmpConfig *cfg) {
+    for (int i = 0; i < SMP_MAX_CPUS; i++) {
+        cfg->core[i] = i;
+        cfg->llc[i] = 0;
+        cfg->node[i] = 0;
+    }
+    cfg->nr_nodes = 1;
+    for (int a = 0; a < SMP_MAX_NODES; a++) {
+        for (int b = 0; b < SMP_MAX_NODES; b++) {
+            cfg->distance[a][b] = (a == b) ? SMP_LOCAL_DISTANCE : 2 * SMP_LOCAL_DISTANCE;
+        }
+    }
+    for (int l = 0; l < TOPO_LEVELS; l++) cfg->migrate_cost[l] = 0;
+    cfg->smt_speed = 100;
+}
+
+int smp_topo_level(const SmpConfig *cfg, int a, int b) {
+    if (a == b) return -1;
+    if (cfg->core[a] == cfg->core[b]) return TOPO_SMT;
+    if (cfg->llc[a] == cfg->llc[b]) return TOPO_LLC;
+    if (cfg->node[a] == cfg->node[b]) return TOPO_NODE;
+    return TOPO_NUMA;
+}
+
+// --- CPU List ---
+
+bool smp_parse_cpus(const char *spec, SmpConfig *cfg) {
+    int count = 0;
+    const char *at = spec;
+    while (*at != '\0') {
+        int a = 0, b = 0, used = 0;
+        int copies = 1, capacity;
+        if (sscanf(at, "%dx%d%n", &a, &b, &used) == 2) {
+            copies = a;
+            capacity = b;
+        } else if (sscanf(at, "%d%n", &a, &used) == 1) {
+            capacity = a;
+        } else {
+            return false;
+        }
+        if (copies < 1 || count + copies > SMP_MAX_CPUS) return false;
+        if (capacity < 1) capacity = 1;
+        if (capacity > SCHED_CAPACITY_SCALE) capacity = SCHED_CAPACITY_SCALE;
+        for (int k = 0; k < copies; k++) cfg->capacity[count++] = capacity;
+
+        at += used;
+        if (*at == ',') at++;
+        else if (*at != '\0') return false;
+    }
+    if (count == 0) return false;
+    cfg->cpu_count = count;
+    smp_flat_topology(cfg);
+    return true;
+}
+
+// --- Topology File ---
+
+static bool topo_error(const char *path, int line, const char *what) {
+    printf("%s:%d: %s\n", path, line, what);
+    return false;
+}
+
+bool smp_load_topology(const char *path, SmpConfig *cfg) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        printf("Cannot open topology '%s'\n", path);
+        return false;
+    }
+
+    SmpConfig t = *cfg;
+    smp_flat_topology(&t);
+    bool seen[SMP_MAX_CPUS] = { false };
+    int count = 0;
+    int max_node = 0;
+
+    char buf[512];
+    int line = 0;
+    bool ok = true;
+    while (ok && fgets(buf, sizeof(buf), fp) != NULL) {
+        line++;
+        char *hash = strchr(buf, '#');
+        if (hash != NULL) *hash = '\0';
+
+        char key[16];
+        int used = 0;
+        if (sscanf(buf, "%15s%n", key, &used) != 1) continue; // Blank line
+        const char *rest = buf + used;
+
+        if (strcmp(key, "cpu") == 0) {
+            int id, core, llc, node, capacity = SCHED_CAPACITY_SCALE;
+            if (sscanf(rest, "%d core %d llc %d node %d%n", &id, &core, &llc, &node, &used) != 4) {
+                ok = topo_error(path, line, "expected: cpu ID core C llc L node N [capacity CAP]");
+                break;
+            }
+            sscanf(rest + used, " capacity %d", &capacity);
+            if (id < 0 || id >= SMP_MAX_CPUS || seen[id]) {
+                ok = topo_error(path, line, "CPU id out of range or repeated");
+                break;
+            }
+            if (node < 0 || node >= SMP_MAX_NODES || core < 0 || core >= SMP_MAX_CPUS ||
+                llc < 0 || llc >= SMP_MAX_CPUS) {
+                ok = topo_error(path, line, "core, llc or node out of range");
+                break;
+            }
+            if (capacity < 1) capacity = 1;
+            if (capacity > SCHED_CAPACITY_SCALE) capacity = SCHED_CAPACITY_SCALE;
+
+            seen[id] = true;
+            t.capacity[id] = capacity;
+            // Cores and LLCs are numbered per node in most descriptions, so
+            // key them by node too
+            t.core[id] = node * SMP_MAX_CPUS * SMP_MAX_CPUS + llc * SMP_MAX_CPUS + core;
+            t.llc[id] = node * SMP_MAX_CPUS + llc;
+            t.node[id] = node;
+            if (id + 1 > count) count = id + 1;
+            if (node > max_node) max_node = node;
+        } else if (strcmp(key, "distance") == 0) {
+            int node;
+            if (sscanf(rest, "%d%n", &node, &used) != 1 || node < 0 || node >= SMP_MAX_NODES) {
+                ok = topo_error(path, line, "expected: distance NODE D0 D1 ...");
+                break;
+            }
+            rest += used;
+            int d, col = 0;
+            while (col < SMP_MAX_NODES && sscanf(rest, "%d%n", &d, &used) == 1) {
+                t.distance[node][col++] = (d > 0) ? d : 1;
+                rest += used;
+            }
+        } else if (strcmp(key, "migrate") == 0) {
+            char level[16];
+            int cost, l;
+            if (sscanf(rest, "%15s %d", level, &cost) != 2) {
+                ok = topo_error(path, line, "expected: migrate smt|llc|node|numa TICKS");
+                break;
+            }
+            for (l = 0; l < TOPO_LEVELS; l++) if (strcmp(level, level_names[l]) == 0) break;
+            if (l == TOPO_LEVELS) {
+                ok = topo_error(path, line, "unknown level");
+                break;
+            }
+            t.migrate_cost[l] = (cost > 0) ? cost : 0;
+        } else if (strcmp(key, "smt_speed") == 0) {
+            if (sscanf(rest, "%d", &t.smt_speed) != 1) {
+                ok = topo_error(path, line, "expected: smt_speed PERCENT");
+                break;
+            }
+            if (t.smt_speed < 1) t.smt_speed = 1;
+            if (t.smt_speed > 100) t.smt_speed = 100;
+        } else {
+            ok = topo_error(path, line, "unknown keyword");
+        }
+    }
+    fclose(fp);
+    if (!ok) return false;
+
+    if (count == 0) return topo_error(path, line, "no CPUs");
+    for (int i = 0; i < count; i++) {
+        if (!seen[i]) return topo_error(path, line, "CPU ids must run from 0 without gaps");
+    }
+    t.cpu_count = count;
+    t.nr_nodes = max_node + 1;
+    *cfg = t;
+    return true;
+}
@@ -0,0 +1,392 @@
+#include <string.h>
+#include <time.h>
+#include "steal.h"
+#include "Arena/arena.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "IO/io.h"
+#include "PropShare/propshare.h"
+#include "Trace/trace.h"
+
+// --- Victim Draws ---
+
+// splitmix64, as in Load/load.c
+static uint64_t draw_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// --- Deques ---
+// Circular array of task indices, grown by doubling when full (the old
+// array stays in the run arena). top..bottom-1 are queued.
+
+typedef struct {
+    int *slot;
+    int mask;                 // Capacity - 1, capacity a power of two
+    int top;                  // Oldest task, where thieves take
+    int bottom;               // Next free slot, where the owner pushes and pops
+} Deque;
+
+#define DEQUE_INITIAL 16
+
+static void deque_init(Deque *d) {
+    d->slot = (int*)arena_alloc(&run_arena, DEQUE_INITIAL * sizeof(int));
+    d->mask = DEQUE_INITIAL - 1;
+    d->top = 0;
+    d->bottom = 0;
+}
+
+static int deque_size(const Deque *d) {
+    return d->bottom - d->top;
+}
+
+static void deque_push(Deque *d, int idx) {
+    if (deque_size(d) == d->mask + 1) {
+        int cap = 2 * (d->mask + 1);
+        int *slot = (int*)arena_alloc(&run_arena, cap * sizeof(int));
+        for (int i = d->top; i < d->bottom; i++) slot[i & (cap - 1)] = d->slot[i & d->mask];
+        d->slot = slot;
+        d->mask = cap - 1;
+    }
+    d->slot[d->bottom++ & d->mask] = idx;
+}
+
+// Owner end: the newest task, -1 if empty
+static int deque_pop(Deque *d) {
+    if (deque_size(d) == 0) return -1;
+    return d->slot[--d->bottom & d->mask];
+}
+
+// Thief end: the oldest task, -1 if empty
+static int deque_steal(Deque *d) {
+    if (deque_size(d) == 0) return -1;
+    return d->slot[d->top++ & d->mask];
+}
+
+// --- Run State ---
+
+typedef struct {
+    int id;
+    Deque dq;
+    Process *curr;
+    Process *cache;           // Cache owner (see cs_swap_owner)
+    int stall;                // Overhead ticks left before curr progresses
+    int run_start;
+    int victim;               // Worker being robbed, -1 = no attempt in flight
+    int steal_until;          // Tick the attempt resolves
+
+    long tasks;
+    long busy, overhead, idle;
+    long attempts, steals, failed;
+    long stolen;              // Tasks other workers took from this one
+    long forked;              // Tasks forked onto this deque
+} Worker;
+
+typedef struct {
+    Process *p;
+    int n;
+    const StealConfig *cfg;
+    Worker *w;
+    int nw;
+
+    // Successors of task i: succ[succ_start[i] .. succ_start[i + 1] - 1]
+    int *succ_start;
+    int *succ;
+    int *waiting;             // Predecessors not yet completed
+
+    int *roots;               // Tasks without dependencies, by arrival
+    int root_count;
+    int next_root;
+
+    int now;
+    int completed;
+    int queued;               // Tasks in any deque
+    int running;              // Workers with a task
+    uint64_t rng;
+} StealSched;
+
+// Dependencies name earlier tasks by PID (input order); others are ignored
+static int dep_index(const Process *x, int i, int k) {
+    int d = x->deps[k] - 1;
+    return (d >= 0 && d < i) ? d : -1;
+}
+
+static void build_dag(StealSched *s) {
+    Process *p = s->p;
+    int n = s->n;
+    s->succ_start = (int*)arena_calloc(&run_arena, n + 1, sizeof(int));
+    s->waiting = (int*)arena_calloc(&run_arena, n, sizeof(int));
+
+    int edges = 0;
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < p[i].dep_count; k++) {
+            int d = dep_index(&p[i], i, k);
+            if (d < 0) continue;
+            s->succ_start[d + 1]++;
+            s->waiting[i]++;
+            edges++;
+        }
+    }
+    for (int i = 0; i < n; i++) s->succ_start[i + 1] += s->succ_start[i];
+
+    // Filled in task order, so every successor list is sorted by PID
+    int *fill = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    memcpy(fill, s->succ_start, n * sizeof(int));
+    s->succ = (int*)arena_alloc(&run_arena, (edges > 0 ? edges : 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < p[i].dep_count; k++) {
+            int d = dep_index(&p[i], i, k);
+            if (d >= 0) s->succ[fill[d]++] = i;
+        }
+    }
+
+    // Roots by arrival, then PID (insertion sort: inputs are mostly in order)
+    s->roots = (int*)arena_alloc(&run_arena, n * sizeof(int));
+    s->root_count = 0;
+    for (int i = 0; i < n; i++) {
+        if (s->waiting[i] > 0) continue;
+        int j = s->root_count++;
+        while (j > 0 && p[s->roots[j - 1]].at > p[i].at) {
+            s->roots[j] = s->roots[j - 1];
+            j--;
+        }
+        s->roots[j] = i;
+    }
+}
+
+// Critical path: with unlimited workers and free steals, task i completes
+// at (its arrival, or its last predecessor's completion) + its burst
+static long dag_span(const StealSched *s, int min_at) {
+    const Process *p = s->p;
+    long *finish = (long*)arena_alloc(&run_arena, s->n * sizeof(long));
+    long span = 0;
+    for (int i = 0; i < s->n; i++) finish[i] = -1;
+    for (int i = 0; i < s->n; i++) {
+        if (s->waiting[i] == 0) finish[i] = p[i].at;
+        finish[i] += p[i].bt;
+        for (int k = s->succ_start[i]; k < s->succ_start[i + 1]; k++) {
+            int j = s->succ[k];
+            if (finish[i] > finish[j]) finish[j] = finish[i];
+        }
+        if (finish[i] - min_at > span) span = finish[i] - min_at;
+    }
+    return span;
+}
+
+// --- Dispatch and Completion ---
+
+static void dispatch(StealSched *s, Worker *w, int idx) {
+    Process *x = &s->p[idx];
+    s->queued--;
+    s->running++;
+
+    cs_swap_owner(w->cache);
+    w->stall = cs_dispatch(x, s->now);
+    w->cache = x;
+    w->curr = x;
+    w->run_start = s->now + w->stall;
+    w->tasks++;
+
+    x->start_time = w->run_start;
+    x->rt = x->start_time - x->at;
+    x->started = true;
+}
+
+// The completing worker forks every task that was waiting only on x
+static void complete(StealSched *s, Worker *w, Process *x) {
+    int end = s->now + 1;
+    x->ct = end;
+    x->tat = x->ct - x->at;
+    x->wt = x->tat - x->bt;
+    x->completed = true;
+    x->last_ran = end;
+    s->completed++;
+    s->running--;
+    w->curr = NULL;
+
+    add_gantt_event(x->pid, w->run_start, end);
+    trace_slice(w->id, x->pid, w->run_start, end, TRACE_END_EXIT);
+    trace_lifetime(x);
+
+    int i = (int)(x - s->p);
+    for (int k = s->succ_start[i]; k < s->succ_start[i + 1]; k++) {
+        int j = s->succ[k];
+        if (--s->waiting[j] > 0) continue;
+        s->p[j].at = end;
+        deque_push(&w->dq, j);
+        s->queued++;
+        w->forked++;
+    }
+}
+
+// --- Taking Work ---
+
+static void start_steal(StealSched *s, Worker *w) {
+    int v = (int)(draw_next(&s->rng) % (uint64_t)(s->nw - 1));
+    w->victim = (v >= w->id) ? v + 1 : v;
+    w->steal_until = s->now + s->cfg->steal_cost;
+    w->attempts++;
+}
+
+// Own deque first; an idle worker otherwise keeps stealing until an
+// attempt succeeds, one attempt per steal_cost ticks
+static void acquire(StealSched *s, Worker *w) {
+    while (1) {
+        if (w->victim < 0) {
+            int idx = deque_pop(&w->dq);
+            if (idx >= 0) {
+                dispatch(s, w, idx);
+                return;
+            }
+            if (s->nw == 1) return;
+            start_steal(s, w);
+        }
+        if (w->steal_until > s->now) return;
+
+        Worker *v = &s->w[w->victim];
+        w->victim = -1;
+        int idx = deque_steal(&v->dq);
+        if (idx >= 0) {
+            w->steals++;
+            v->stolen++;
+            dispatch(s, w, idx);
+            return;
+        }
+        w->failed++;
+        if (s->cfg->steal_cost == 0) return;
+    }
+}
+
+static void worker_tick(StealSched *s, Worker *w) {
+    Process *x = w->curr;
+    if (x == NULL) {
+        w->idle++;
+        return;
+    }
+    if (w->stall > 0) {
+        w->stall--;
+        w->overhead++;
+        return;
+    }
+    w->busy++;
+    if (--x->rem_bt == 0) complete(s, w, x);
+}
+
+// --- Simulation Loop ---
+
+static void steal_step(StealSched *s) {
+    Process *p = s->p;
+
+    // Roots are submitted by the thread that started the computation
+    while (s->next_root < s->root_count && p[s->roots[s->next_root]].at <= s->now) {
+        deque_push(&s->w[0].dq, s->roots[s->next_root++]);
+        s->queued++;
+    }
+
+    // Nothing anywhere to run or steal: skip to the next root, every
+    // worker idle meanwhile and no attempt can succeed
+    if (s->queued == 0 && s->running == 0 && s->next_root < s->root_count) {
+        int next = p[s->roots[s->next_root]].at;
+        for (int i = 0; i < s->nw; i++) {
+            s->w[i].idle += next - s->now;
+            s->w[i].victim = -1;
+        }
+        s->now = next;
+        return;
+    }
+
+    for (int i = 0; i < s->nw; i++) {
+        if (s->w[i].curr == NULL) acquire(s, &s->w[i]);
+    }
+    for (int i = 0; i < s->nw; i++) worker_tick(s, &s->w[i]);
+    s->now++;
+}
+
+// --- Report ---
+
+static void print_workers(const StealSched *s) {
+    printf("\n--- Work-Stealing Workers ---\n\n");
+    printf("Worker\tTasks\tBusy\tOverhead\tIdle\tAttempts\tSteals\tStolen\tForked\n");
+    for (int i = 0; i < s->nw; i++) {
+        const Worker *w = &s->w[i];
+        printf("%d\t%ld\t%ld\t%ld\t%ld\t%ld\t%ld\t%ld\t%ld\n", w->id, w->tasks, w->busy, w->overhead,
+               w->idle, w->attempts, w->steals, w->stolen, w->forked);
+    }
+}
+
+// --- Entry Point ---
+
+void run_steal(Process p[], int n, const StealConfig *cfg) {
+    if (io_enabled) {
+        printf("Work-stealing mode does not support I/O phases.\n");
+        return;
+    }
+    if (n <= 0) return;
+
+    StealSched *s = (StealSched*)arena_calloc(&run_arena, 1, sizeof(StealSched));
+    s->p = p;
+    s->n = n;
+    s->cfg = cfg;
+    s->nw = cfg->workers;
+    if (s->nw < 1) s->nw = 1;
+    if (s->nw > STEAL_MAX_WORKERS) s->nw = STEAL_MAX_WORKERS;
+    uint64_t seed = lottery_seed ? lottery_seed : (uint64_t)time(NULL);
+    s->rng = seed ^ lottery_stream;
+
+    reset_processes(p, n);
+    build_dag(s);
+    s->w = (Worker*)arena_calloc(&run_arena, s->nw, sizeof(Worker));
+    for (int i = 0; i < s->nw; i++) {
+        s->w[i].id = i;
+        s->w[i].victim = -1;
+        deque_init(&s->w[i].dq);
+    }
+
+    int min_at = (s->root_count > 0) ? p[s->roots[0]].at : 0;
+    long work = 0;
+    for (int i = 0; i < n; i++) work += p[i].bt;
+    long span = dag_span(s, min_at);
+
+    if (!sim_quiet) {
+        printf("Starting Simulation (Work Stealing, %d workers, %d roots, steal cost %d)...\n",
+               s->nw, s->root_count, cfg->steal_cost);
+    }
+
+    s->now = min_at;
+    while (s->completed < n && !sim_should_stop(s->now)) {
+        steal_step(s);
+    }
+
+    sim_capacity = s->nw;
+    print_table(p, n, "Work Stealing");
+    sim_capacity = 1.0;
+    if (sim_quiet) return;
+    print_workers(s);
+
+    long attempts = 0, steals = 0, idle = 0;
+    for (int i = 0; i < s->nw; i++) {
+        attempts += s->w[i].attempts;
+        steals += s->w[i].steals;
+        idle += s->w[i].idle;
+    }
+    int makespan = s->now - min_at;
+    if (makespan < 1) makespan = 1;
+    double per_worker = (double)work / s->nw;
+    double bound = (per_worker > span) ? per_worker : (double)span;
+
+    printf("\n");
+    printf("Workers                    = %d (steal cost %d ticks)\n", s->nw, cfg->steal_cost);
+    printf("Work                       = %ld ticks\n", work);
+    printf("Span                       = %ld ticks (critical path)\n", span);
+    printf("Parallelism                = %.2f (work / span)\n", span > 0 ? (double)work / span : 0.0);
+    printf("Makespan                   = %d ticks\n", makespan);
+    printf("Lower Bound                = %.2f ticks (max of work / workers, span)\n", bound);
+    printf("Span/Work Efficiency       = %.2f%% (lower bound / makespan)\n", 100.0 * bound / makespan);
+    printf("Speedup                    = %.2f (work / makespan)\n", (double)work / makespan);
+    printf("Steals                     = %ld of %ld attempts (%.2f%%)\n", steals, attempts,
+           attempts ? 100.0 * steals / attempts : 0.0);
+    printf("Idle Time                  = %ld worker ticks (%.2f%% of capacity)\n", idle,
+           100.0 * idle / ((double)s->nw * makespan));
+    printf("Seed                       = %llu\n", (unsigned long long)seed);
+}
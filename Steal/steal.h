@@ -0,0 +1,47 @@
+#ifndef STEAL_H
+#define STEAL_H
+
+#include "common.h"
+
+// --- Work-Stealing Runtime (fork-join task DAGs) ---
+// A user-level task runtime rather than an OS scheduler: 'workers' threads
+// each own a deque of ready tasks, and tasks run to completion once
+// started. The workload is a DAG: a task may join on earlier tasks
+// (Process.deps, by PID), and it is forked when the last of them
+// completes, onto the deque of the worker that completed it. Its arrival
+// time becomes that tick (an entered arrival time only matters for tasks
+// without dependencies, the roots, which are submitted to worker 0).
+//
+// Deques follow Chase-Lev: the owner pushes and pops at the bottom (LIFO,
+// the task it forked last, whose data is still warm), thieves take from
+// the top (FIFO, the oldest and usually largest piece of work). A worker
+// whose deque is empty picks a victim uniformly at random among the other
+// workers and spends 'steal_cost' ticks on the attempt before it learns
+// whether the victim had anything; a failed attempt starts the next one.
+// With steal_cost 0 a worker makes one attempt per tick. Victims are drawn
+// from one splitmix64 stream seeded with lottery_seed (--seed), so a run
+// is reproducible.
+//
+// Every tick all workers first take work (own deque, then steal
+// resolution) in worker order, then each runs its task for one tick, so a
+// task forked at tick t can be stolen from tick t + 1. The context-switch
+// and cache model applies per worker as in SMP/. I/O phases are not
+// supported.
+//
+// Besides the usual results table the report has per-worker busy,
+// overhead and idle ticks, steals and failed attempts, and the DAG's work
+// (sum of bursts) and span (critical path), compared with the makespan:
+// no schedule on P workers beats max(work / P, span).
+
+#define STEAL_MAX_WORKERS 64
+#define STEAL_DEFAULT_WORKERS 4
+#define STEAL_DEFAULT_COST 1
+
+typedef struct {
+    int workers;              // 1..STEAL_MAX_WORKERS
+    int steal_cost;           // Ticks per steal attempt
+} StealConfig;
+
+void run_steal(Process p[], int n, const StealConfig *cfg);
+
+#endif
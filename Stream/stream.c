@@ -0,0 +1,406 @@
+#include <string.h>
+#include "stream.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+
+// Slots are allocated in slabs that never move, so queues can hold pointers
+#define STREAM_SLAB 4096
+
+// --- Slot Pool ---
+
+typedef struct {
+    Process **slabs;
+    int slab_count;
+    int slab_cap;
+    int fresh;              // Unused slots left in the newest slab
+    Process **free;         // Recycled slots
+    int free_count;
+    int free_cap;
+} SlotPool;
+
+static Process* pool_acquire(SlotPool *pool) {
+    if (pool->free_count > 0) return pool->free[--pool->free_count];
+
+    if (pool->fresh == 0) {
+        if (pool->slab_count == pool->slab_cap) {
+            pool->slab_cap = pool->slab_cap ? pool->slab_cap * 2 : 16;
+            pool->slabs = (Process**)realloc(pool->slabs, pool->slab_cap * sizeof(Process*));
+        }
+        pool->slabs[pool->slab_count++] = (Process*)malloc(STREAM_SLAB * sizeof(Process));
+        pool->fresh = STREAM_SLAB;
+    }
+    return &pool->slabs[pool->slab_count - 1][STREAM_SLAB - pool->fresh--];
+}
+
+static void pool_release(SlotPool *pool, Process *slot) {
+    if (pool->free_count == pool->free_cap) {
+        pool->free_cap = pool->free_cap ? pool->free_cap * 2 : 64;
+        pool->free = (Process**)realloc(pool->free, pool->free_cap * sizeof(Process*));
+    }
+    pool->free[pool->free_count++] = slot;
+}
+
+static void pool_free(SlotPool *pool) {
+    for (int i = 0; i < pool->slab_count; i++) free(pool->slabs[i]);
+    free(pool->slabs);
+    free(pool->free);
+}
+
+// --- Ready Structures ---
+
+// FIFO ring of slots (FCFS, RR)
+typedef struct {
+    Process **buf;
+    int head;
+    int count;
+    int cap;
+} Ring;
+
+static void ring_push(Ring *r, Process *x) {
+    if (r->count == r->cap) {
+        int cap = r->cap ? r->cap * 2 : 64;
+        Process **buf = (Process**)malloc(cap * sizeof(Process*));
+        for (int i = 0; i < r->count; i++) buf[i] = r->buf[(r->head + i) % r->cap];
+        free(r->buf);
+        r->buf = buf;
+        r->head = 0;
+        r->cap = cap;
+    }
+    r->buf[(r->head + r->count++) % r->cap] = x;
+}
+
+static Process* ring_pop(Ring *r) {
+    Process *x = r->buf[r->head];
+    r->head = (r->head + 1) % r->cap;
+    r->count--;
+    return x;
+}
+
+// Binary min-heap of slots (SJF, Priority)
+typedef bool (*HeapBefore)(const Process *a, const Process *b);
+
+typedef struct {
+    Process **buf;
+    int count;
+    int cap;
+    HeapBefore before;
+} Heap;
+
+static void heap_push(Heap *h, Process *x) {
+    if (h->count == h->cap) {
+        h->cap = h->cap ? h->cap * 2 : 64;
+        h->buf = (Process**)realloc(h->buf, h->cap * sizeof(Process*));
+    }
+    int i = h->count++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!h->before(x, h->buf[parent])) break;
+        h->buf[i] = h->buf[parent];
+        i = parent;
+    }
+    h->buf[i] = x;
+}
+
+static Process* heap_pop(Heap *h) {
+    Process *top = h->buf[0];
+    Process *last = h->buf[--h->count];
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= h->count) break;
+        if (child + 1 < h->count && h->before(h->buf[child + 1], h->buf[child])) child++;
+        if (!h->before(h->buf[child], last)) break;
+        h->buf[i] = h->buf[child];
+        i = child;
+    }
+    if (h->count > 0) h->buf[i] = last;
+    return top;
+}
+
+// Same picks as the scan loops in SJF/sjf.c and Priority/priority.c:
+// key first, then earlier arrival, then input order (= PID)
+static bool sjf_before(const Process *a, const Process *b) {
+    if (a->rem_bt != b->rem_bt) return a->rem_bt < b->rem_bt;
+    if (a->at != b->at) return a->at < b->at;
+    return a->pid < b->pid;
+}
+
+static bool priority_before(const Process *a, const Process *b) {
+    if (a->priority != b->priority) return a->priority < b->priority;
+    if (a->at != b->at) return a->at < b->at;
+    return a->pid < b->pid;
+}
+
+// --- Run State ---
+
+typedef struct {
+    // Workload source: 'next' is the first process not yet admitted
+    int algo;
+    FILE *in;
+    long remaining;
+    int next_pid;
+    bool has_next;
+    bool unsorted;
+    Process next;
+
+    // Results sink and running metrics
+    FILE *sink;
+    long completed;
+    double total_wt, total_tat, total_rt;
+    long total_burst;
+    int max_wt, max_rt;
+    int min_at, max_ct;
+    double fair_sum, fair_sq;   // Jain's index terms, see calculate_jain_fairness
+
+    SlotPool pool;
+    long active;
+    long peak_active;
+} StreamRun;
+
+static void source_read(StreamRun *r) {
+    int last_at = r->next.at;
+    r->has_next = false;
+    if (r->remaining <= 0) return;
+
+    Process *x = &r->next;
+    memset(x, 0, sizeof(Process));
+    if (fscanf(r->in, "%d %d", &x->at, &x->bt) != 2) return;
+    if (r->algo == 2 && fscanf(r->in, "%d", &x->priority) != 1) return;
+
+    x->pid = ++r->next_pid;
+    r->remaining--;
+    if (x->pid > 1 && x->at < last_at) {
+        printf("Streaming input must be sorted by arrival time: process %d arrives at %d after %d\n",
+               x->pid, x->at, last_at);
+        r->unsorted = true;
+        return;
+    }
+    r->has_next = true;
+}
+
+// Moves the next process from the source into a slot
+static Process* admit(StreamRun *r) {
+    Process *x = pool_acquire(&r->pool);
+    *x = r->next;
+    x->rem_bt = x->bt;
+    x->last_ran = -1;
+    io_reset_process(x);
+
+    if (r->active == 0 && r->completed == 0) r->min_at = x->at;
+    if (++r->active > r->peak_active) r->peak_active = r->active;
+
+    source_read(r);
+    return x;
+}
+
+static bool arrived(const StreamRun *r, int now) {
+    return r->has_next && r->next.at <= now;
+}
+
+static void start(Process *x, int now) {
+    if (!x->started) {
+        x->start_time = now;
+        x->rt = now - x->at;
+        x->started = true;
+    }
+}
+
+// Records a finished process and recycles its slot
+static void complete(StreamRun *r, Process *x, int now) {
+    x->ct = now;
+    x->tat = x->ct - x->at;
+    x->wt = x->tat - x->bt;
+    x->completed = true;
+
+    fprintf(r->sink, "%d\t%d\t%d\t%d\t%d\t%d\n", x->pid, x->at, x->bt, x->wt, x->tat, x->rt);
+
+    r->completed++;
+    r->total_wt += x->wt;
+    r->total_tat += x->tat;
+    r->total_rt += x->rt;
+    r->total_burst += x->bt;
+    if (x->wt > r->max_wt) r->max_wt = x->wt;
+    if (x->rt > r->max_rt) r->max_rt = x->rt;
+    if (x->ct > r->max_ct) r->max_ct = x->ct;
+    double allocation = (x->bt > 0) ? (double)x->bt / x->tat : 0.0;
+    r->fair_sum += allocation;
+    r->fair_sq += allocation * allocation;
+
+    cs_retire(x);
+    pool_release(&r->pool, x);
+    r->active--;
+}
+
+// --- Schedulers ---
+
+static void stream_fcfs(StreamRun *r) {
+    Ring ready = { NULL, 0, 0, 0 };
+    int now = 0;
+
+    while (r->has_next || ready.count > 0) {
+        while (arrived(r, now)) ring_push(&ready, admit(r));
+        if (ready.count == 0) {
+            now = r->next.at; // CPU idle until the next arrival
+            continue;
+        }
+
+        Process *x = ring_pop(&ready);
+        now += cs_dispatch(x, now);
+        start(x, now);
+        now += x->rem_bt;
+        x->rem_bt = 0;
+        complete(r, x, now);
+    }
+    free(ready.buf);
+}
+
+// Preemptive SJF and Priority. The chosen process keeps the CPU until it
+// completes or the next arrival could preempt it, which gives the same
+// schedule as re-picking every tick.
+static void stream_preemptive(StreamRun *r, HeapBefore before) {
+    Heap ready = { NULL, 0, 0, before };
+    int now = 0;
+
+    while (r->has_next || ready.count > 0) {
+        while (arrived(r, now)) heap_push(&ready, admit(r));
+        if (ready.count == 0) {
+            now = r->next.at;
+            continue;
+        }
+
+        Process *x = heap_pop(&ready);
+        now += cs_dispatch(x, now);
+        start(x, now);
+
+        int run = x->rem_bt;
+        if (r->has_next && r->next.at - now < run) {
+            run = (r->next.at > now) ? r->next.at - now : 1;
+        }
+        now += run;
+        x->rem_bt -= run;
+
+        if (x->rem_bt == 0) complete(r, x, now);
+        else heap_push(&ready, x);
+    }
+    free(ready.buf);
+}
+
+// RR/rr.c sweeps the process table in input order, picking up arrivals as
+// the sweep reaches them. Here the current sweep is one queue, survivors
+// line up for the next sweep in another, and arrivals join at the end of
+// the current sweep.
+static void stream_rr(StreamRun *r, int tq) {
+    Ring sweep = { NULL, 0, 0, 0 };
+    Ring next_sweep = { NULL, 0, 0, 0 };
+    int now = r->has_next ? r->next.at : 0;
+
+    while (r->has_next || sweep.count > 0) {
+        bool worked = false;
+        while (1) {
+            Process *x;
+            if (sweep.count > 0) x = ring_pop(&sweep);
+            else if (arrived(r, now)) x = admit(r);
+            else break;
+            worked = true;
+
+            now += cs_dispatch(x, now);
+            start(x, now);
+            int exec_time = (x->rem_bt > tq) ? tq : x->rem_bt;
+            now += exec_time;
+            x->rem_bt -= exec_time;
+
+            if (x->rem_bt == 0) complete(r, x, now);
+            else ring_push(&next_sweep, x);
+        }
+
+        Ring t = sweep;
+        sweep = next_sweep;
+        next_sweep = t;
+        if (!worked && r->has_next) now = r->next.at;
+    }
+    free(sweep.buf);
+    free(next_sweep.buf);
+}
+
+// --- Report ---
+
+static void print_summary(StreamRun *r, const char *algo_name) {
+    long n = r->completed;
+    double total_time = r->max_ct - r->min_at;
+    if (total_time <= 0) total_time = 1;
+    long total_overhead = cs_switch_overhead + cs_cache_overhead;
+
+    size_t bytes = (size_t)r->pool.slab_count * STREAM_SLAB * sizeof(Process)
+                 + (size_t)r->pool.free_cap * sizeof(Process*);
+
+    printf("\n");
+    printf("Average Waiting Time       = %.2f\n", n ? r->total_wt / n : 0.0);
+    printf("Average Turnaround Time    = %.2f\n", n ? r->total_tat / n : 0.0);
+    printf("Average Response Time      = %.2f\n", n ? r->total_rt / n : 0.0);
+    printf("Max Waiting Time           = %d\n", r->max_wt);
+    printf("Max Response Time          = %d\n", r->max_rt);
+    printf("CPU Utilization            = %.2f%%\n", (r->total_burst + total_overhead) / total_time * 100.0);
+    printf("Effective CPU Utilization  = %.2f%%\n", r->total_burst / total_time * 100.0);
+    printf("Context Switches           = %ld\n", cs_switch_count);
+    printf("Switch Overhead            = %ld (switch %ld + cache %ld)\n",
+           total_overhead, cs_switch_overhead, cs_cache_overhead);
+    printf("Throughput                 = %.2f processes/unit time\n", n / total_time);
+    printf("Jain Fairness Index        = %.4f\n",
+           (r->fair_sq > 0) ? (r->fair_sum * r->fair_sum) / (n * r->fair_sq) : 0.0);
+    printf("\n--- %s Streaming ---\n\n", algo_name);
+    printf("Processes Streamed         = %ld\n", n);
+    printf("Peak Active Processes      = %ld\n", r->peak_active);
+    printf("Process Slots Allocated    = %d\n", r->pool.slab_count * STREAM_SLAB);
+    printf("Slot Memory                = %zu bytes\n", bytes);
+}
+
+// --- Entry Point ---
+
+bool run_stream(int algo, long n, int time_quantum, FILE *in, FILE *sink) {
+    const char *algo_name;
+    switch (algo) {
+        case 1: algo_name = "FCFS Scheduling"; break;
+        case 2: algo_name = "Preemptive Priority"; break;
+        case 3: algo_name = "SRTF (Preemptive SJF)"; break;
+        case 4: algo_name = "Round Robin"; break;
+        default:
+            printf("Streaming mode supports FCFS, Priority, SJF and RR only.\n");
+            return false;
+    }
+    if (io_enabled) {
+        printf("Streaming mode does not support I/O phases.\n");
+        return false;
+    }
+    if (time_quantum < 1) time_quantum = 1;
+
+    printf("Starting Streaming Simulation (%s, %ld processes)...\n", algo_name, n);
+
+    StreamRun r;
+    memset(&r, 0, sizeof(r));
+    r.algo = algo;
+    r.in = in;
+    r.remaining = n;
+    r.sink = sink;
+    cs_reset();
+    source_read(&r);
+
+    fprintf(sink, "\n--- %s Results ---\n\n", algo_name);
+    fprintf(sink, "PID\tAT\tBT\tWT\tTAT\tRT\n");
+
+    switch (algo) {
+        case 1: stream_fcfs(&r); break;
+        case 2: stream_preemptive(&r, priority_before); break;
+        case 3: stream_preemptive(&r, sjf_before); break;
+        case 4: stream_rr(&r, time_quantum); break;
+    }
+    fflush(sink);
+
+    bool ok = !r.unsorted;
+    if (ok && r.completed < n) {
+        printf("Workload ended after %ld of %ld processes.\n", r.completed, n);
+    }
+    if (ok) print_summary(&r, algo_name);
+
+    pool_free(&r.pool);
+    return ok;
+}
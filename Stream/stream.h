@@ -0,0 +1,24 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdio.h>
+#include "common.h"
+
+// --- Streaming Simulation ---
+// For workloads too large to hold in memory. Processes are read from the
+// input one at a time, in arrival order, only once the simulated clock
+// reaches them; a completed process is written to the results sink at once
+// and its slot is recycled for a later arrival. Summary metrics are kept as
+// running sums, so memory is proportional to the peak number of processes
+// in the system rather than to the workload size.
+//
+// Input is the usual stdin format without prompts, and must be sorted by
+// arrival time. Supported: FCFS (1), Priority (2), SJF (3), RR (4), without
+// I/O phases. Results match the regular simulators for the same workload;
+// the Gantt chart is not recorded.
+
+// Runs the workload of 'n' processes still waiting on 'in'. Completed rows go
+// to 'sink'. Returns false on unsupported options or unsorted input.
+bool run_stream(int algo, long n, int time_quantum, FILE *in, FILE *sink);
+
+#endif
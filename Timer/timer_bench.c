@@ -0,0 +1,215 @@
+#include <time.h>
+#include "timer_wheel.h"
+
+#define BENCH_MIN_TIMERS 10000
+#define BENCH_SPAN (1 << 20)      // Expiries spread over this many ticks
+#define BENCH_CANCEL_PCT 10       // Share of timers cancelled before expiry
+
+// --- Indexed Binary Heap (the baseline) ---
+// Like the I/O sleep queue: (expiry, owner) entries, plus each owner's heap
+// position so that a timer can be cancelled.
+
+typedef struct {
+    int key;
+    int owner;
+} HeapEntry;
+
+typedef struct {
+    HeapEntry *entries;
+    int *pos;                 // Owner -> index in entries, -1 = not queued
+    int count;
+} TimerHeap;
+
+static void heap_set(TimerHeap *h, int i, HeapEntry x) {
+    h->entries[i] = x;
+    h->pos[x.owner] = i;
+}
+
+static void heap_sift_up(TimerHeap *h, int i) {
+    HeapEntry x = h->entries[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (h->entries[parent].key <= x.key) break;
+        heap_set(h, i, h->entries[parent]);
+        i = parent;
+    }
+    heap_set(h, i, x);
+}
+
+static void heap_sift_down(TimerHeap *h, int i) {
+    HeapEntry x = h->entries[i];
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= h->count) break;
+        if (child + 1 < h->count && h->entries[child + 1].key < h->entries[child].key) child++;
+        if (x.key <= h->entries[child].key) break;
+        heap_set(h, i, h->entries[child]);
+        i = child;
+    }
+    heap_set(h, i, x);
+}
+
+static void heap_insert(TimerHeap *h, int owner, int key) {
+    HeapEntry x = { key, owner };
+    h->entries[h->count] = x;
+    heap_sift_up(h, h->count++);
+}
+
+static void heap_remove(TimerHeap *h, int owner) {
+    int i = h->pos[owner];
+    if (i < 0) return;
+    h->pos[owner] = -1;
+    HeapEntry last = h->entries[--h->count];
+    if (i == h->count) return;
+    h->entries[i] = last;
+    h->pos[last.owner] = i;
+    if (i > 0 && h->entries[(i - 1) / 2].key > last.key) heap_sift_up(h, i);
+    else heap_sift_down(h, i);
+}
+
+// --- Workload ---
+
+static uint64_t bench_state;
+
+// splitmix64: enough for benchmark inputs, and the same on every platform
+static uint64_t bench_next(void) {
+    uint64_t z = (bench_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double elapsed_ns(clock_t start, long ops) {
+    return (ops > 0) ? (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ops : 0.0;
+}
+
+typedef struct {
+    double insert_ns, cancel_ns, expire_ns;
+    long expired;
+    uint64_t checksum;        // Sum over expiries of (tick, owner)
+    bool on_time;             // Every timer expired exactly at its tick
+} BenchResult;
+
+// Same expiries, same cancellations, then the clock runs tick by tick to
+// the end of the span expiring everything due
+static void bench_wheel(int n, const int *expires, const int *cancel, int n_cancel, BenchResult *r) {
+    TimerWheel *w = (TimerWheel*)malloc(sizeof(TimerWheel));
+    TimerNode *nodes = (TimerNode*)malloc(n * sizeof(TimerNode));
+    tw_init(w, 0);
+    for (int i = 0; i < n; i++) tw_node_init(&nodes[i], i);
+
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) tw_add(w, &nodes[i], expires[i]);
+    r->insert_ns = elapsed_ns(start, n);
+
+    start = clock();
+    for (int k = 0; k < n_cancel; k++) tw_cancel(w, &nodes[cancel[k]]);
+    r->cancel_ns = elapsed_ns(start, n_cancel);
+
+    r->expired = 0;
+    r->checksum = 0;
+    r->on_time = true;
+    start = clock();
+    for (int now = 0; now <= BENCH_SPAN; now++) {
+        for (TimerNode *t = tw_advance(w, now); t != NULL; t = t->next) {
+            r->checksum += (uint64_t)now * 1000003 + t->owner;
+            if (t->expires != now) r->on_time = false;
+            r->expired++;
+        }
+    }
+    r->expire_ns = elapsed_ns(start, r->expired);
+
+    free(nodes);
+    free(w);
+}
+
+static void bench_heap(int n, const int *expires, const int *cancel, int n_cancel, BenchResult *r) {
+    TimerHeap h;
+    h.entries = (HeapEntry*)malloc(n * sizeof(HeapEntry));
+    h.pos = (int*)malloc(n * sizeof(int));
+    h.count = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) heap_insert(&h, i, expires[i]);
+    r->insert_ns = elapsed_ns(start, n);
+
+    start = clock();
+    for (int k = 0; k < n_cancel; k++) heap_remove(&h, cancel[k]);
+    r->cancel_ns = elapsed_ns(start, n_cancel);
+
+    r->expired = 0;
+    r->checksum = 0;
+    r->on_time = true;
+    start = clock();
+    for (int now = 0; now <= BENCH_SPAN; now++) {
+        while (h.count > 0 && h.entries[0].key <= now) {
+            int owner = h.entries[0].owner;
+            if (h.entries[0].key != now) r->on_time = false;
+            heap_remove(&h, owner);
+            r->checksum += (uint64_t)now * 1000003 + owner;
+            r->expired++;
+        }
+    }
+    r->expire_ns = elapsed_ns(start, r->expired);
+
+    free(h.entries);
+    free(h.pos);
+}
+
+// What both runs must produce: every timer not cancelled, at its own tick
+static uint64_t tick_sum_checksum(int n, const int *expires, const bool *cancelled) {
+    uint64_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        if (!cancelled[i]) sum += (uint64_t)expires[i] * 1000003 + i;
+    }
+    return sum;
+}
+
+// --- Entry Point ---
+
+void run_timer_bench(int max_timers) {
+    if (max_timers < BENCH_MIN_TIMERS) max_timers = BENCH_MIN_TIMERS;
+    printf("Timer Micro-Benchmark: %d ticks, %d%% cancelled, ns per operation (CPU time)\n",
+           BENCH_SPAN, BENCH_CANCEL_PCT);
+    printf("Wheel: %d levels x %d slots, %d bytes per timer; heap: %d bytes per timer\n\n",
+           TW_LEVELS, TW_SLOTS, (int)sizeof(TimerNode), (int)(sizeof(HeapEntry) + sizeof(int)));
+    printf("Timers\tW Insert\tH Insert\tW Cancel\tH Cancel\tW Expire\tH Expire\tMatch\n");
+
+    for (long n = BENCH_MIN_TIMERS; n <= max_timers; n *= 10) {
+        int *expires = (int*)malloc(n * sizeof(int));
+        int n_cancel = (int)(n * BENCH_CANCEL_PCT / 100);
+        int *cancel = (int*)malloc(n_cancel * sizeof(int));
+        bool *cancelled = (bool*)calloc(n, sizeof(bool));
+        if (expires == NULL || cancel == NULL || cancelled == NULL) {
+            printf("%ld\tout of memory\n", n);
+            free(expires);
+            free(cancel);
+            free(cancelled);
+            break;
+        }
+
+        bench_state = (uint64_t)n;
+        for (long i = 0; i < n; i++) expires[i] = 1 + (int)(bench_next() % BENCH_SPAN);
+        for (int k = 0; k < n_cancel; k++) {
+            int i;
+            do {
+                i = (int)(bench_next() % n);
+            } while (cancelled[i]);
+            cancelled[i] = true;
+            cancel[k] = i;
+        }
+
+        BenchResult wr, hr;
+        bench_wheel((int)n, expires, cancel, n_cancel, &wr);
+        bench_heap((int)n, expires, cancel, n_cancel, &hr);
+        uint64_t expect = tick_sum_checksum((int)n, expires, cancelled);
+        bool match = wr.on_time && hr.on_time && wr.checksum == expect && hr.checksum == expect;
+
+        printf("%ld\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%s\n", n, wr.insert_ns, hr.insert_ns,
+               wr.cancel_ns, hr.cancel_ns, wr.expire_ns, hr.expire_ns, match ? "yes" : "NO");
+
+        free(expires);
+        free(cancel);
+        free(cancelled);
+    }
+}
@@ -0,0 +1,187 @@
+#include "timer_wheel.h"
+
+// --- Slot Lists ---
+
+static void list_init(TimerNode *head) {
+    head->next = head;
+    head->prev = head;
+}
+
+static void list_append(TimerNode *head, TimerNode *t) {
+    t->prev = head->prev;
+    t->next = head;
+    head->prev->next = t;
+    head->prev = t;
+}
+
+static bool list_empty(const TimerNode *head) {
+    return head->next == head;
+}
+
+// Index of the lowest set bit
+static int lowest_bit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int k = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        k++;
+    }
+    return k;
+#endif
+}
+
+// --- Placement ---
+
+// Level by distance from the wheel's clock, slot by the expiry's digit at
+// that level. A timer already due goes to the current level-0 slot.
+static void wheel_place(TimerWheel *w, TimerNode *t) {
+    int64_t expires = (t->expires > w->clk) ? t->expires : w->clk;
+    int64_t delta = expires - w->clk;
+    int level = 0;
+    while (level < TW_LEVELS - 1 && delta >= ((int64_t)1 << ((level + 1) * TW_BITS))) level++;
+    int s = (int)((expires >> (level * TW_BITS)) & TW_MASK);
+    list_append(&w->slot[level][s], t);
+    w->occupied[level] |= (uint64_t)1 << s;
+
+    // The slot comes up once the digits below this level are zero
+    int64_t at = expires & ~(((int64_t)1 << (level * TW_BITS)) - 1);
+    if (at < w->next_event) w->next_event = at;
+}
+
+void tw_init(TimerWheel *w, int now) {
+    for (int l = 0; l < TW_LEVELS; l++) {
+        for (int s = 0; s < TW_SLOTS; s++) list_init(&w->slot[l][s]);
+        w->occupied[l] = 0;
+    }
+    w->clk = now;
+    w->next_event = INT64_MAX;
+    w->count = 0;
+}
+
+void tw_node_init(TimerNode *t, int owner) {
+    t->next = NULL;
+    t->prev = NULL;
+    t->expires = 0;
+    t->owner = owner;
+}
+
+void tw_add(TimerWheel *w, TimerNode *t, int expires) {
+    if (tw_pending(t)) tw_cancel(w, t);
+    t->expires = expires;
+    wheel_place(w, t);
+    w->count++;
+}
+
+// The slot's occupied bit is cleared lazily, the next time it is looked at
+void tw_cancel(TimerWheel *w, TimerNode *t) {
+    if (!tw_pending(t)) return;
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    t->next = NULL;
+    t->prev = NULL;
+    w->count--;
+}
+
+// --- Expiry ---
+
+// First tick at or after the clock at which 'level' has work: a level-0
+// slot expiring, or a higher slot cascading down (its digit comes up with
+// all lower digits zero). -1 if the level is empty.
+static int64_t level_next_event(TimerWheel *w, int level, int *slot) {
+    int shift = level * TW_BITS;
+    int64_t start = w->clk >> shift;
+    if (level > 0 && (w->clk & (((int64_t)1 << shift) - 1)) != 0) start++;
+    int r = (int)(start & TW_MASK);
+
+    while (w->occupied[level] != 0) {
+        uint64_t bits = w->occupied[level];
+        uint64_t rotated = (r == 0) ? bits : (bits >> r) | (bits << (TW_SLOTS - r));
+        int s = (r + lowest_bit(rotated)) & TW_MASK;
+        if (list_empty(&w->slot[level][s])) {
+            w->occupied[level] &= ~((uint64_t)1 << s); // Emptied by cancels
+            continue;
+        }
+        *slot = s;
+        return (start + ((s - r) & TW_MASK)) << shift;
+    }
+    return -1;
+}
+
+static int64_t wheel_next_event(TimerWheel *w) {
+    int64_t next = -1;
+    int s;
+    for (int l = 0; l < TW_LEVELS; l++) {
+        int64_t at = level_next_event(w, l, &s);
+        if (at != -1 && (next == -1 || at < next)) next = at;
+    }
+    return next;
+}
+
+// Re-places every timer of a higher-level slot relative to the clock
+static void cascade(TimerWheel *w, int level, int s) {
+    TimerNode *head = &w->slot[level][s];
+    TimerNode *t = head->next;
+    list_init(head);
+    w->occupied[level] &= ~((uint64_t)1 << s);
+    while (t != head) {
+        TimerNode *next = t->next;
+        wheel_place(w, t);
+        t = next;
+    }
+}
+
+TimerNode* tw_advance(TimerWheel *w, int now) {
+    TimerNode *first = NULL, *last = NULL;
+
+    while (w->count > 0 && w->clk <= now && w->next_event <= now) {
+        int64_t at = wheel_next_event(w);
+        w->next_event = (at == -1) ? INT64_MAX : at;
+        if (at == -1 || at > now) break;
+        w->clk = at;
+
+        // Cascade from level 1 up for as long as the lower digits are zero
+        for (int l = 1; l < TW_LEVELS; l++) {
+            if ((at & (((int64_t)1 << (l * TW_BITS)) - 1)) != 0) break;
+            cascade(w, l, (int)((at >> (l * TW_BITS)) & TW_MASK));
+        }
+
+        // Everything left in the current level-0 slot is due now
+        int s = (int)(at & TW_MASK);
+        TimerNode *head = &w->slot[0][s];
+        while (!list_empty(head)) {
+            TimerNode *t = head->next;
+            tw_cancel(w, t);
+            if (last == NULL) first = t;
+            else last->next = t;
+            last = t;
+        }
+        w->occupied[0] &= ~((uint64_t)1 << s);
+        w->clk = at + 1;
+        w->next_event = w->clk; // Not known yet, but no earlier
+    }
+    if (w->clk <= now) w->clk = (int64_t)now + 1;
+    return first;
+}
+
+// Per level, the slot that comes up first holds that level's earliest
+// timers (later slots only hold later digits), so only one slot per level
+// is scanned, and none whose cascade is already past the best found
+int tw_next_expiry(TimerWheel *w) {
+    int64_t best = -1;
+    for (int l = 0; l < TW_LEVELS; l++) {
+        int s;
+        int64_t at = level_next_event(w, l, &s);
+        if (at == -1 || (best != -1 && at >= best)) continue;
+        if (l == 0) {
+            best = at;
+            continue;
+        }
+        TimerNode *head = &w->slot[l][s];
+        for (TimerNode *t = head->next; t != head; t = t->next) {
+            if (best == -1 || t->expires < best) best = t->expires;
+        }
+    }
+    return (int)best;
+}
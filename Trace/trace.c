@@ -0,0 +1,349 @@
+#include <stdarg.h>
+#include <string.h>
+#include "trace.h"
+
+#define TRACE_JSON     0
+#define TRACE_PERFETTO 1
+
+static const char *end_names[TRACE_END_REASONS] = {
+    "preempted", "resched", "yield", "sleep", "exit", "migrated"
+};
+
+static FILE *trace_fp = NULL;
+static int trace_format = TRACE_JSON;
+static bool trace_paused = false;
+static bool trace_first = true;           // JSON: no comma before the first event
+
+// --- Track Bookkeeping ---
+// A track is described once, the first time an event lands on it
+
+#define TRACK_CPU     0
+#define TRACK_TASK    1
+#define TRACK_COUNTER 2
+#define TRACK_KINDS   3
+
+static unsigned char *track_seen[TRACK_KINDS];
+static int track_capacity[TRACK_KINDS];
+
+static bool track_first_use(int kind, int id) {
+    if (id < 0) return false;
+    if (id >= track_capacity[kind]) {
+        int capacity = track_capacity[kind] ? track_capacity[kind] : 64;
+        while (capacity <= id) capacity *= 2;
+        track_seen[kind] = (unsigned char*)realloc(track_seen[kind], capacity);
+        memset(track_seen[kind] + track_capacity[kind], 0, capacity - track_capacity[kind]);
+        track_capacity[kind] = capacity;
+    }
+    if (track_seen[kind][id]) return false;
+    track_seen[kind][id] = 1;
+    return true;
+}
+
+static bool trace_active(void) {
+    return trace_fp != NULL && !trace_paused && !sim_quiet;
+}
+
+static int64_t tick_us(int tick) {
+    return (int64_t)tick * TRACE_TICK_US;
+}
+
+// --- Chrome Trace-Event JSON ---
+// pid 0 holds one thread per CPU, pid 1 one thread per task
+
+static void json_event(const char *fmt, ...) {
+    va_list args;
+    fputs(trace_first ? "\n" : ",\n", trace_fp);
+    trace_first = false;
+    va_start(args, fmt);
+    vfprintf(trace_fp, fmt, args);
+    va_end(args);
+}
+
+static void json_open(void) {
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", trace_fp);
+    json_event("{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"CPUs\"}}");
+    json_event("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"Tasks\"}}");
+}
+
+static void json_slice(int cpu, int pid, int start, int end, int reason) {
+    if (track_first_use(TRACK_CPU, cpu)) {
+        json_event("{\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"CPU %d\"}}",
+                   cpu, cpu);
+    }
+    json_event("{\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%lld,\"dur\":%lld,\"name\":\"P%d\",\"args\":{\"end\":\"%s\"}}",
+               cpu, (long long)tick_us(start), (long long)tick_us(end - start), pid, end_names[reason]);
+}
+
+static void json_task_track(int pid) {
+    if (track_first_use(TRACK_TASK, pid)) {
+        json_event("{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"P%d\"}}",
+                   pid, pid);
+    }
+}
+
+static void json_lifetime(const Process *x) {
+    json_task_track(x->pid);
+    json_event("{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"dur\":%lld,\"name\":\"P%d\","
+               "\"args\":{\"wt\":%d,\"tat\":%d,\"rt\":%d}}",
+               x->pid, (long long)tick_us(x->at), (long long)tick_us(x->ct - x->at), x->pid,
+               x->wt, x->tat, x->rt);
+}
+
+static void json_counter(int pid, int time, double value) {
+    json_event("{\"ph\":\"C\",\"pid\":1,\"ts\":%lld,\"name\":\"P%d vruntime\",\"args\":{\"vruntime\":%.4f}}",
+               (long long)tick_us(time), pid, value);
+}
+
+static void json_close(void) {
+    fputs("\n]}\n", trace_fp);
+}
+
+// --- Perfetto Protobuf ---
+// Hand-encoded: the file is a Trace message, a sequence of field-1
+// TracePacket records. Field numbers are those of perfetto's
+// trace_packet.proto, track_descriptor.proto and track_event.proto.
+
+#define PB_VARINT 0
+#define PB_FIXED64 1
+#define PB_BYTES 2
+
+#define PACKET_TIMESTAMP       8
+#define PACKET_SEQUENCE_ID     10
+#define PACKET_TRACK_EVENT     11
+#define PACKET_SEQUENCE_FLAGS  13
+#define PACKET_TRACK_DESC      60
+#define SEQ_INCREMENTAL_STATE_CLEARED 1
+
+#define DESC_UUID        1
+#define DESC_NAME        2
+#define DESC_PARENT_UUID 5
+#define DESC_COUNTER     8
+
+#define EVENT_ANNOTATION 4
+#define EVENT_TYPE       9
+#define EVENT_TRACK_UUID 11
+#define EVENT_NAME       23
+#define EVENT_COUNTER    44          // double_counter_value
+#define TYPE_SLICE_BEGIN 1
+#define TYPE_SLICE_END   2
+#define TYPE_COUNTER     4
+
+#define ANNOTATION_INT    4
+#define ANNOTATION_STRING 6
+#define ANNOTATION_NAME   10
+
+// Track uuids: one group per kind, then one track per CPU / task
+#define UUID_CPUS  1
+#define UUID_TASKS 2
+#define UUID_TRACK(kind, id) (((uint64_t)(kind) + 1) << 32 | (uint32_t)(id))
+
+typedef struct {
+    uint8_t data[256];
+    int len;
+} PbBuf;
+
+static bool perfetto_first = true;
+
+static void pb_byte(PbBuf *b, uint8_t v) {
+    if (b->len < (int)sizeof(b->data)) b->data[b->len] = v;
+    b->len++;
+}
+
+static void pb_varint(PbBuf *b, uint64_t v) {
+    while (v >= 0x80) {
+        pb_byte(b, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    pb_byte(b, (uint8_t)v);
+}
+
+static void pb_key(PbBuf *b, int field, int wire) {
+    pb_varint(b, ((uint64_t)field << 3) | wire);
+}
+
+static void pb_uint(PbBuf *b, int field, uint64_t v) {
+    pb_key(b, field, PB_VARINT);
+    pb_varint(b, v);
+}
+
+static void pb_double(PbBuf *b, int field, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    pb_key(b, field, PB_FIXED64);
+    for (int i = 0; i < 8; i++) pb_byte(b, (uint8_t)(bits >> (8 * i)));
+}
+
+static void pb_bytes(PbBuf *b, int field, const uint8_t *data, int len) {
+    pb_key(b, field, PB_BYTES);
+    pb_varint(b, (uint64_t)len);
+    for (int i = 0; i < len; i++) pb_byte(b, data[i]);
+}
+
+static void pb_string(PbBuf *b, int field, const char *s) {
+    pb_bytes(b, field, (const uint8_t*)s, (int)strlen(s));
+}
+
+static void pb_message(PbBuf *b, int field, const PbBuf *inner) {
+    pb_bytes(b, field, inner->data, inner->len);
+}
+
+// Wraps 'body' (TracePacket fields) as one packet of the Trace message
+static void perfetto_emit(PbBuf *body) {
+    pb_uint(body, PACKET_SEQUENCE_ID, 1);
+    if (perfetto_first) {
+        pb_uint(body, PACKET_SEQUENCE_FLAGS, SEQ_INCREMENTAL_STATE_CLEARED);
+        perfetto_first = false;
+    }
+    if (body->len > (int)sizeof(body->data)) return; // Cannot happen with our short names
+
+    PbBuf head = { { 0 }, 0 };
+    pb_key(&head, 1, PB_BYTES);
+    pb_varint(&head, (uint64_t)body->len);
+    fwrite(head.data, 1, head.len, trace_fp);
+    fwrite(body->data, 1, body->len, trace_fp);
+}
+
+static void perfetto_track(uint64_t uuid, uint64_t parent, const char *name, bool counter) {
+    PbBuf desc = { { 0 }, 0 }, packet = { { 0 }, 0 };
+    pb_uint(&desc, DESC_UUID, uuid);
+    pb_string(&desc, DESC_NAME, name);
+    if (parent != 0) pb_uint(&desc, DESC_PARENT_UUID, parent);
+    if (counter) pb_bytes(&desc, DESC_COUNTER, NULL, 0);
+    pb_message(&packet, PACKET_TRACK_DESC, &desc);
+    perfetto_emit(&packet);
+}
+
+static void perfetto_annotation(PbBuf *event, const char *name, const char *text, int value) {
+    PbBuf a = { { 0 }, 0 };
+    pb_string(&a, ANNOTATION_NAME, name);
+    if (text != NULL) pb_string(&a, ANNOTATION_STRING, text);
+    else pb_uint(&a, ANNOTATION_INT, (uint64_t)(int64_t)value);
+    pb_message(event, EVENT_ANNOTATION, &a);
+}
+
+static void perfetto_event(int time, const PbBuf *event) {
+    PbBuf packet = { { 0 }, 0 };
+    pb_uint(&packet, PACKET_TIMESTAMP, (uint64_t)tick_us(time) * 1000);
+    pb_message(&packet, PACKET_TRACK_EVENT, event);
+    perfetto_emit(&packet);
+}
+
+static void perfetto_slice_end(int time, uint64_t uuid) {
+    PbBuf event = { { 0 }, 0 };
+    pb_uint(&event, EVENT_TYPE, TYPE_SLICE_END);
+    pb_uint(&event, EVENT_TRACK_UUID, uuid);
+    perfetto_event(time, &event);
+}
+
+static void perfetto_open(void) {
+    perfetto_track(UUID_CPUS, 0, "CPUs", false);
+    perfetto_track(UUID_TASKS, 0, "Tasks", false);
+}
+
+static void perfetto_task_track(int pid) {
+    if (track_first_use(TRACK_TASK, pid)) {
+        char name[32];
+        snprintf(name, sizeof(name), "P%d", pid);
+        perfetto_track(UUID_TRACK(TRACK_TASK, pid), UUID_TASKS, name, false);
+    }
+}
+
+static void perfetto_slice(int cpu, int pid, int start, int end, int reason) {
+    uint64_t uuid = UUID_TRACK(TRACK_CPU, cpu);
+    char name[32];
+    if (track_first_use(TRACK_CPU, cpu)) {
+        snprintf(name, sizeof(name), "CPU %d", cpu);
+        perfetto_track(uuid, UUID_CPUS, name, false);
+    }
+
+    PbBuf event = { { 0 }, 0 };
+    snprintf(name, sizeof(name), "P%d", pid);
+    pb_uint(&event, EVENT_TYPE, TYPE_SLICE_BEGIN);
+    pb_uint(&event, EVENT_TRACK_UUID, uuid);
+    pb_string(&event, EVENT_NAME, name);
+    perfetto_annotation(&event, "end", end_names[reason], 0);
+    perfetto_event(start, &event);
+    perfetto_slice_end(end, uuid);
+}
+
+static void perfetto_lifetime(const Process *x) {
+    uint64_t uuid = UUID_TRACK(TRACK_TASK, x->pid);
+    perfetto_task_track(x->pid);
+
+    PbBuf event = { { 0 }, 0 };
+    char name[32];
+    snprintf(name, sizeof(name), "P%d", x->pid);
+    pb_uint(&event, EVENT_TYPE, TYPE_SLICE_BEGIN);
+    pb_uint(&event, EVENT_TRACK_UUID, uuid);
+    pb_string(&event, EVENT_NAME, name);
+    perfetto_annotation(&event, "wt", NULL, x->wt);
+    perfetto_annotation(&event, "tat", NULL, x->tat);
+    perfetto_annotation(&event, "rt", NULL, x->rt);
+    perfetto_event(x->at, &event);
+    perfetto_slice_end(x->ct, uuid);
+}
+
+static void perfetto_counter(int pid, int time, double value) {
+    uint64_t uuid = UUID_TRACK(TRACK_COUNTER, pid);
+    if (track_first_use(TRACK_COUNTER, pid)) {
+        char name[32];
+        perfetto_task_track(pid);
+        snprintf(name, sizeof(name), "P%d vruntime", pid);
+        perfetto_track(uuid, UUID_TRACK(TRACK_TASK, pid), name, true);
+    }
+
+    PbBuf event = { { 0 }, 0 };
+    pb_uint(&event, EVENT_TYPE, TYPE_COUNTER);
+    pb_uint(&event, EVENT_TRACK_UUID, uuid);
+    pb_double(&event, EVENT_COUNTER, value);
+    perfetto_event(time, &event);
+}
+
+// --- Public Interface ---
+
+bool trace_open(const char *path) {
+    size_t len = strlen(path);
+    trace_format = (len >= 5 && strcmp(path + len - 5, ".json") == 0) ? TRACE_JSON : TRACE_PERFETTO;
+    trace_fp = fopen(path, (trace_format == TRACE_JSON) ? "w" : "wb");
+    if (trace_fp == NULL) return false;
+
+    trace_first = true;
+    perfetto_first = true;
+    if (trace_format == TRACE_JSON) json_open();
+    else perfetto_open();
+    return true;
+}
+
+void trace_close(void) {
+    if (trace_fp == NULL) return;
+    if (trace_format == TRACE_JSON) json_close();
+    fclose(trace_fp);
+    trace_fp = NULL;
+    for (int k = 0; k < TRACK_KINDS; k++) {
+        free(track_seen[k]);
+        track_seen[k] = NULL;
+        track_capacity[k] = 0;
+    }
+}
+
+void trace_pause(bool paused) {
+    trace_paused = paused;
+}
+
+void trace_slice(int cpu, int pid, int start, int end, int reason) {
+    if (!trace_active() || end <= start) return;
+    if (trace_format == TRACE_JSON) json_slice(cpu, pid, start, end, reason);
+    else perfetto_slice(cpu, pid, start, end, reason);
+}
+
+void trace_lifetime(const Process *x) {
+    if (!trace_active()) return;
+    if (trace_format == TRACE_JSON) json_lifetime(x);
+    else perfetto_lifetime(x);
+}
+
+void trace_counter(int pid, int time, double value) {
+    if (!trace_active()) return;
+    if (trace_format == TRACE_JSON) json_counter(pid, time, value);
+    else perfetto_counter(pid, time, value);
+}
@@ -0,0 +1,48 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "common.h"
+
+// --- Timeline Trace Export ---
+// --trace FILE writes the scheduling timeline while the simulation runs,
+// for ui.perfetto.dev (or chrome://tracing for JSON). Events go straight
+// to the file as they happen, so memory stays constant however long the
+// run. The format follows the file name:
+//   *.json                       Chrome trace-event JSON
+//   anything else (*.pftrace)    Perfetto protobuf (TrackDescriptor and
+//                                TrackEvent packets on one sequence)
+//
+// Tracks:
+//   CPU n           one slice per run of a task, named P<pid>, with the
+//                   reason it ended (see TRACE_END_*)
+//   P<pid>          the task's lifetime, arrival to completion, with its
+//                   waiting, turnaround and response times
+//   P<pid> vruntime counter fed by add_vruntime_log (CFS, EEVDF, SMP), one
+//                   point where each run of the task starts and ends
+//
+// One tick is TRACE_TICK_US microseconds on the trace timeline. Runs with
+// sim_quiet set (tuner candidates, Monte Carlo replicas) are not traced.
+
+#define TRACE_TICK_US 1000
+
+// Why a slice ended
+#define TRACE_END_PREEMPT  0   // A waking or arriving task took the CPU
+#define TRACE_END_RESCHED  1   // The class switched tasks at a tick (slice, quantum, deadline)
+#define TRACE_END_YIELD    2   // The task gave up the CPU (quantum rotation, throttling)
+#define TRACE_END_SLEEP    3   // Blocked on I/O
+#define TRACE_END_EXIT     4   // Completed
+#define TRACE_END_MIGRATE  5   // Moved to another CPU
+#define TRACE_END_REASONS  6
+
+// Opens the trace file; false if it cannot be created
+bool trace_open(const char *path);
+// Finishes the file (JSON needs its closing brackets)
+void trace_close(void);
+// While paused nothing is recorded (what-if replays re-run the timeline)
+void trace_pause(bool paused);
+
+void trace_slice(int cpu, int pid, int start, int end, int reason);
+void trace_lifetime(const Process *x);
+void trace_counter(int pid, int time, double value);
+
+#endif
@@ -0,0 +1,406 @@
+#include <string.h>
+#include "tune.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "RR/rr.h"
+#include "MLFQ/mlfq.h"
+#include "CFS/cfs.h"
+#include "Arena/arena.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define TUNE_THREADS 1
+#endif
+
+// Search space limits
+#define TUNE_MAX_QUANTUM 64
+#define TUNE_MAX_LATENCY 24
+#define TUNE_MAX_GRANULARITY 8
+
+// Objective lower bound is re-evaluated every this many scheduler iterations
+#define TUNE_POLL_INTERVAL 32
+
+typedef enum { CAND_PENDING, CAND_DONE, CAND_PRUNED, CAND_OVER_BUDGET } CandidateStatus;
+
+typedef struct {
+    int a;                 // RR/MLFQ: quantum, CFS: latency
+    int b;                 // CFS: min granularity
+    CandidateStatus status;
+    double objective;
+    long switches;
+    SimMetrics m;
+} Candidate;
+
+typedef struct {
+    int algo;
+    Process *workload;
+    int n;
+    TuneConfig cfg;
+
+    Candidate *cands;
+    int count;
+    int next;              // Next candidate to claim
+#ifdef TUNE_THREADS
+    pthread_mutex_t lock;
+#endif
+} Tuner;
+
+#ifdef TUNE_THREADS
+#define TUNER_LOCK(t) pthread_mutex_lock(&(t)->lock)
+#define TUNER_UNLOCK(t) pthread_mutex_unlock(&(t)->lock)
+#else
+#define TUNER_LOCK(t) ((void)0)
+#define TUNER_UNLOCK(t) ((void)0)
+#endif
+
+// Run being evaluated on this thread (read by the stop hook)
+typedef struct {
+    Tuner *tuner;
+    Process *p;
+    long polls;
+    CandidateStatus stop_reason;
+} TuneRun;
+
+static THREAD_LOCAL TuneRun tune_run;
+
+static const char *objective_names[] = { "p99_rt", "avg_rt", "avg_wt", "avg_tat", "p99_tat" };
+
+bool tune_parse_objective(const char *name, TuneObjective *obj) {
+    for (int i = 0; i < (int)(sizeof(objective_names) / sizeof(objective_names[0])); i++) {
+        if (strcmp(name, objective_names[i]) == 0) {
+            *obj = (TuneObjective)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Objective ---
+// Per-task lower bounds that can only grow as the run proceeds and equal
+// the final values once every task has completed:
+//   response   : exact once started, else time already waited
+//   turnaround : exact once completed, else time in system + CPU still owed
+//   waiting    : exact once completed, else time in system not spent running or in I/O
+static double objective_bound(Process p[], int n, int now, TuneObjective obj) {
+    double *v = (double*)malloc(n * sizeof(double));
+    double sum = 0;
+
+    for (int i = 0; i < n; i++) {
+        int in_system = (now > p[i].at) ? now - p[i].at : 0;
+        switch (obj) {
+            case OBJ_P99_RT:
+            case OBJ_AVG_RT:
+                v[i] = p[i].started ? p[i].rt : in_system;
+                break;
+            case OBJ_P99_TAT:
+            case OBJ_AVG_TAT:
+                v[i] = p[i].completed ? p[i].tat : in_system + p[i].rem_bt;
+                break;
+            case OBJ_AVG_WT: {
+                int idle = in_system - (p[i].bt - p[i].rem_bt) - p[i].io_time;
+                v[i] = p[i].completed ? p[i].wt : (idle > 0 ? idle : 0);
+                break;
+            }
+        }
+        sum += v[i];
+    }
+
+    double result;
+    if (obj == OBJ_P99_RT || obj == OBJ_P99_TAT) result = percentile(v, n, 99.0);
+    else result = sum / n;
+
+    free(v);
+    return result;
+}
+
+// --- Early Termination ---
+
+static bool tune_stop_hook(int now) {
+    TuneRun *r = &tune_run;
+    Tuner *t = r->tuner;
+
+    if (t->cfg.switch_budget > 0 && cs_switch_count > t->cfg.switch_budget) {
+        r->stop_reason = CAND_OVER_BUDGET;
+        return true;
+    }
+    if (++r->polls % TUNE_POLL_INTERVAL != 0) return false;
+
+    // Strict dominance only: candidates that tie a finished one still finish,
+    // so the reported front does not depend on thread timing.
+    double bound = objective_bound(r->p, t->n, now, t->cfg.objective);
+    bool dominated = false;
+    TUNER_LOCK(t);
+    for (int i = 0; i < t->count && !dominated; i++) {
+        Candidate *c = &t->cands[i];
+        if (c->status != CAND_DONE) continue;
+        if ((c->objective < bound && c->switches <= cs_switch_count) ||
+            (c->objective <= bound && c->switches < cs_switch_count)) {
+            dominated = true;
+        }
+    }
+    TUNER_UNLOCK(t);
+
+    if (dominated) r->stop_reason = CAND_PRUNED;
+    return dominated;
+}
+
+// --- Evaluation ---
+
+static void apply_params(int algo, const Candidate *c) {
+    if (algo == 5) mlfq_quantum = c->a;
+    if (algo == 9) {
+        sched_latency = c->a;
+        sched_min_granularity = c->b;
+    }
+}
+
+static void run_candidate(int algo, Process p[], int n, const Candidate *c) {
+    apply_params(algo, c);
+    switch (algo) {
+        case 4: run_rr(p, n, c->a); break;
+        case 5: run_mlfq(p, n); break;
+        case 9: run_cfs(p, n); break;
+    }
+}
+
+static void evaluate(Tuner *t, int idx, Process p[]) {
+    Candidate c = t->cands[idx];
+
+    memcpy(p, t->workload, t->n * sizeof(Process));
+    tune_run.p = p;
+    tune_run.polls = 0;
+    tune_run.stop_reason = CAND_DONE;
+
+    run_candidate(t->algo, p, t->n, &c);
+
+    c.status = tune_run.stop_reason;
+    c.switches = cs_switch_count;
+    if (c.status == CAND_DONE && t->cfg.switch_budget > 0 && c.switches > t->cfg.switch_budget) {
+        c.status = CAND_OVER_BUDGET; // Last switches happened after the final poll
+    }
+    if (c.status == CAND_DONE) {
+        compute_metrics(p, t->n, &c.m);
+        c.objective = objective_bound(p, t->n, c.m.makespan, t->cfg.objective);
+    }
+
+    TUNER_LOCK(t);
+    t->cands[idx] = c;
+    TUNER_UNLOCK(t);
+}
+
+// Each candidate is one run: its task table and everything the simulation
+// allocates go back to the arena before the next one
+static void* tune_worker(void *arg) {
+    Tuner *t = (Tuner*)arg;
+    ArenaMark mark = arena_mark(&run_arena);
+
+    sim_quiet = true;
+    sim_stop_hook = tune_stop_hook;
+    tune_run.tuner = t;
+
+    while (1) {
+        TUNER_LOCK(t);
+        int idx = (t->next < t->count) ? t->next++ : -1;
+        TUNER_UNLOCK(t);
+        if (idx < 0) break;
+        Process *p = (Process*)arena_alloc(&run_arena, t->n * sizeof(Process));
+        evaluate(t, idx, p);
+        arena_rewind(&run_arena, mark);
+    }
+
+    sim_quiet = false;
+    sim_stop_hook = NULL;
+#ifdef TUNE_THREADS
+    TUNER_LOCK(t);
+    arena_merge_peak(&run_arena);
+    TUNER_UNLOCK(t);
+    sim_release_thread();
+#endif
+    return NULL;
+}
+
+// --- Search Space ---
+
+static int build_candidates(int algo, Process p[], int n, Candidate **out) {
+    // Quanta beyond the longest CPU burst all behave the same
+    int max_burst = 1;
+    for (int i = 0; i < n; i++) {
+        if (p[i].bursts == NULL) {
+            if (p[i].bt > max_burst) max_burst = p[i].bt;
+        } else {
+            for (int k = 0; k < p[i].burst_count; k += 2) {
+                if (p[i].bursts[k] > max_burst) max_burst = p[i].bursts[k];
+            }
+        }
+    }
+    if (max_burst > TUNE_MAX_QUANTUM) max_burst = TUNE_MAX_QUANTUM;
+
+    int count = 0;
+    Candidate *c = NULL;
+    if (algo == 4 || algo == 5) {
+        c = (Candidate*)calloc(max_burst, sizeof(Candidate));
+        for (int q = 1; q <= max_burst; q++) {
+            c[count].a = q;
+            count++;
+        }
+    } else if (algo == 9) {
+        c = (Candidate*)calloc(TUNE_MAX_LATENCY * TUNE_MAX_GRANULARITY, sizeof(Candidate));
+        for (int lat = 1; lat <= TUNE_MAX_LATENCY; lat++) {
+            for (int gran = 1; gran <= lat && gran <= TUNE_MAX_GRANULARITY; gran++) {
+                c[count].a = lat;
+                c[count].b = gran;
+                count++;
+            }
+        }
+    }
+    *out = c;
+    return count;
+}
+
+static void format_params(int algo, const Candidate *c, char *buf, size_t len) {
+    if (algo == 9) snprintf(buf, len, "latency=%d,gran=%d", c->a, c->b);
+    else snprintf(buf, len, "quantum=%d", c->a);
+}
+
+// --- Reporting ---
+
+static bool dominates(const Candidate *x, const Candidate *y) {
+    return x->objective <= y->objective && x->switches <= y->switches &&
+           (x->objective < y->objective || x->switches < y->switches);
+}
+
+static int compare_front(const void *a, const void *b) {
+    const Candidate *x = *(const Candidate* const*)a;
+    const Candidate *y = *(const Candidate* const*)b;
+    if (x->switches != y->switches) return (x->switches > y->switches) - (x->switches < y->switches);
+    return (x->objective > y->objective) - (x->objective < y->objective);
+}
+
+static void print_report(Tuner *t, const char *algo_name, int threads) {
+    int done = 0, pruned = 0, over = 0;
+    for (int i = 0; i < t->count; i++) {
+        if (t->cands[i].status == CAND_DONE) done++;
+        else if (t->cands[i].status == CAND_PRUNED) pruned++;
+        else if (t->cands[i].status == CAND_OVER_BUDGET) over++;
+    }
+
+    const char *obj = objective_names[t->cfg.objective];
+    printf("\n--- Parameter Tuning: %s ---\n\n", algo_name);
+    printf("Objective                  = %s\n", obj);
+    printf("Switch Budget              = %ld%s\n", t->cfg.switch_budget,
+           (t->cfg.switch_budget > 0) ? "" : " (unlimited)");
+    printf("Candidates                 = %d (completed %d, pruned %d, over budget %d)\n",
+           t->count, done, pruned, over);
+    printf("Threads                    = %d\n", threads);
+
+    // Front: completed candidates not dominated by any other completed one.
+    // Candidates with identical scores are listed once (first in search
+    // order) with the number of equivalent settings.
+    Candidate **front = (Candidate**)malloc(t->count * sizeof(Candidate*));
+    int *ties = (int*)calloc(t->count, sizeof(int));
+    int front_count = 0;
+    for (int i = 0; i < t->count; i++) {
+        Candidate *c = &t->cands[i];
+        if (c->status != CAND_DONE) continue;
+        bool dominated = false;
+        for (int j = 0; j < t->count && !dominated; j++) {
+            if (j != i && t->cands[j].status == CAND_DONE && dominates(&t->cands[j], c))
+                dominated = true;
+        }
+        if (dominated) continue;
+
+        int k;
+        for (k = 0; k < front_count; k++) {
+            if (front[k]->objective == c->objective && front[k]->switches == c->switches) break;
+        }
+        if (k < front_count) {
+            ties[front[k] - t->cands]++;
+        } else {
+            front[front_count++] = c;
+        }
+    }
+    qsort(front, front_count, sizeof(Candidate*), compare_front);
+
+    printf("\n--- Pareto Front (%s vs Context Switches) ---\n\n", obj);
+    printf("Params\t%s\tSwitches\tAvgWT\tAvgTAT\tAvgRT\tTies\n", obj);
+    char params[48];
+    for (int i = 0; i < front_count; i++) {
+        format_params(t->algo, front[i], params, sizeof(params));
+        printf("%s\t%.2f\t%ld\t%.2f\t%.2f\t%.2f\t%d\n", params, front[i]->objective, front[i]->switches,
+               front[i]->m.avg_wt, front[i]->m.avg_tat, front[i]->m.avg_rt, ties[front[i] - t->cands]);
+    }
+    free(ties);
+    free(front);
+}
+
+// Lowest objective within budget; ties go to fewer switches, then search order
+static Candidate* best_candidate(Tuner *t) {
+    Candidate *best = NULL;
+    for (int i = 0; i < t->count; i++) {
+        Candidate *c = &t->cands[i];
+        if (c->status != CAND_DONE) continue;
+        if (best == NULL || c->objective < best->objective ||
+            (c->objective == best->objective && c->switches < best->switches)) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+// --- Entry Point ---
+
+bool run_tuner(int algo, Process p[], int n, TuneConfig cfg) {
+    const char *algo_name;
+    switch (algo) {
+        case 4: algo_name = "RR"; break;
+        case 5: algo_name = "MLFQ"; break;
+        case 9: algo_name = "CFS"; break;
+        default: return false;
+    }
+
+    Tuner t;
+    t.algo = algo;
+    t.workload = p;
+    t.n = n;
+    t.cfg = cfg;
+    t.next = 0;
+    t.count = build_candidates(algo, p, n, &t.cands);
+
+    int threads = 1;
+#ifdef TUNE_THREADS
+    threads = cfg.threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > t.count) threads = t.count;
+#endif
+
+    printf("Starting Parameter Search (%s, %d candidates, %d threads)...\n", algo_name, t.count, threads);
+
+#ifdef TUNE_THREADS
+    pthread_mutex_init(&t.lock, NULL);
+    pthread_t *workers = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    for (int i = 0; i < threads; i++) pthread_create(&workers[i], NULL, tune_worker, &t);
+    for (int i = 0; i < threads; i++) pthread_join(workers[i], NULL);
+    free(workers);
+    pthread_mutex_destroy(&t.lock);
+#else
+    tune_worker(&t);
+#endif
+
+    print_report(&t, algo_name, threads);
+
+    // Re-run the winner normally so the usual results follow
+    Candidate *best = best_candidate(&t);
+    char params[48];
+    if (best != NULL) {
+        format_params(algo, best, params, sizeof(params));
+        printf("\nBest                       = %s (%s %.2f, %ld switches)\n\n",
+               params, objective_names[cfg.objective], best->objective, best->switches);
+        run_candidate(algo, p, n, best);
+    } else {
+        printf("\nBest                       = none within the switch budget\n");
+    }
+
+    free(t.cands);
+    return true;
+}
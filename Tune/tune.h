@@ -0,0 +1,38 @@
+#ifndef TUNE_H
+#define TUNE_H
+
+#include "common.h"
+
+// --- Automatic Parameter Tuning ---
+// Searches the tunables of one scheduler on a fixed workload:
+//   RR   (4): time quantum
+//   MLFQ (5): Q0 quantum
+//   CFS  (9): sched_latency x sched_min_granularity
+// Every candidate is simulated quietly (in parallel on all cores where
+// pthreads are available) and scored on an objective plus its context
+// switch count. A run is abandoned as soon as it exceeds the switch budget,
+// or when a lower bound on its objective shows it is already strictly
+// dominated by a finished candidate. The Pareto front over
+// (objective, switches) is reported and the best candidate within budget
+// is re-run normally.
+
+typedef enum {
+    OBJ_P99_RT,
+    OBJ_AVG_RT,
+    OBJ_AVG_WT,
+    OBJ_AVG_TAT,
+    OBJ_P99_TAT
+} TuneObjective;
+
+typedef struct {
+    TuneObjective objective;
+    long switch_budget;   // 0 = unlimited
+    int threads;          // 0 = one per online CPU
+} TuneConfig;
+
+bool tune_parse_objective(const char *name, TuneObjective *obj);
+
+// Returns false (without running anything) if 'algo' has no tunables
+bool run_tuner(int algo, Process p[], int n, TuneConfig cfg);
+
+#endif
@@ -1,20 +1,95 @@
 #pragma once
+#include <math.h>
+#include <string.h>
 #include "common.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
+#include "Trace/trace.h"
+#include "Arena/arena.h"
 
 // --- Global Log Arrays ---
-GanttEvent gantt_log[MAX_GANTT_EVENTS];
-int gantt_log_count = 0;
+THREAD_LOCAL GanttEvent gantt_log[MAX_GANTT_EVENTS];
+THREAD_LOCAL int gantt_log_count = 0;
 
-VRuntimeLog vruntime_log[MAX_VRUNTIME_LOGS];
-int vruntime_log_count = 0;
+THREAD_LOCAL VRuntimeSegment vruntime_log[MAX_VRUNTIME_LOGS];
+THREAD_LOCAL int vruntime_log_count = 0;
+
+static THREAD_LOCAL VRuntimeSegment vruntime_open[VRUNTIME_OPEN_SLOTS];
+static THREAD_LOCAL uint64_t vruntime_open_mask = 0;   // Bit s = slot s holds an open segment
+static THREAD_LOCAL int vruntime_open_index[VRUNTIME_OPEN_SLOTS]; // Log entry reserved at open, -1 = past the cap
 
 // --- Log Management Functions ---
 void reset_logs(void) {
     gantt_log_count = 0;
     vruntime_log_count = 0;
+    vruntime_open_mask = 0;
+}
+
+// --- Progress Streaming ---
+int progress_interval = 0;
+
+static THREAD_LOCAL Process *progress_p = NULL;
+static THREAD_LOCAL int progress_n = 0;
+static THREAD_LOCAL int progress_next = 0;
+static THREAD_LOCAL bool progress_paused = false;
+
+// Segments closed since the last record (not capped like gantt_log)
+static THREAD_LOCAL GanttEvent *progress_pending = NULL;
+static THREAD_LOCAL int progress_pending_count = 0;
+static THREAD_LOCAL int progress_pending_capacity = 0;
+
+void progress_reset(Process p[], int n) {
+    progress_p = p;
+    progress_n = n;
+    progress_next = progress_interval;
+    progress_pending_count = 0;
+}
+
+void progress_pause(bool paused) {
+    progress_paused = paused;
+}
+
+void progress_flush(int now) {
+    if (progress_interval <= 0 || sim_quiet || progress_paused) return;
+
+    int completed = 0;
+    for (int i = 0; i < progress_n; i++) {
+        if (progress_p[i].completed) completed++;
+    }
+
+    printf("PROGRESS {\"time\":%d,\"completed\":%d,\"total\":%d,\"gantt\":[",
+           now, completed, progress_n);
+    for (int i = 0; i < progress_pending_count; i++) {
+        printf("{\"pid\":%d,\"start\":%d,\"end\":%d}%s",
+               progress_pending[i].pid,
+               progress_pending[i].start_time,
+               progress_pending[i].end_time,
+               (i < progress_pending_count - 1) ? "," : "");
+    }
+    printf("]}\n");
+    fflush(stdout);
+
+    progress_pending_count = 0;
+    while (progress_next <= now) progress_next += progress_interval;
+}
+
+static void progress_note(int pid, int start, int end) {
+    if (progress_pending_count == progress_pending_capacity) {
+        progress_pending_capacity = progress_pending_capacity ? progress_pending_capacity * 2 : 64;
+        progress_pending = (GanttEvent*)realloc(progress_pending,
+                                                progress_pending_capacity * sizeof(GanttEvent));
+    }
+    progress_pending[progress_pending_count].pid = pid;
+    progress_pending[progress_pending_count].start_time = start;
+    progress_pending[progress_pending_count].end_time = end;
+    progress_pending_count++;
+
+    if (end >= progress_next) progress_flush(end);
 }
 
 void add_gantt_event(int pid, int start, int end) {
+    if (progress_interval > 0 && !sim_quiet && !progress_paused) progress_note(pid, start, end);
+
     if (gantt_log_count < MAX_GANTT_EVENTS) {
         gantt_log[gantt_log_count].pid = pid;
         gantt_log[gantt_log_count].start_time = start;
@@ -23,13 +98,86 @@ void add_gantt_event(int pid, int start, int end) {
     }
 }
 
-void add_vruntime_log(int real_time, int pid, double vruntime) {
-    if (vruntime_log_count < MAX_VRUNTIME_LOGS) {
-        vruntime_log[vruntime_log_count].real_time = real_time;
-        vruntime_log[vruntime_log_count].pid = pid;
-        vruntime_log[vruntime_log_count].vruntime = vruntime;
-        vruntime_log_count++;
+// --- VRuntime Segments ---
+
+static int64_t segment_end_value(const VRuntimeSegment *g) {
+    return g->vruntime + (int64_t)(g->end - g->start) * g->rate;
+}
+
+// The log entry was reserved when the segment opened, so the log stays in
+// start order whenever segments close; the trace got the start point then
+static void close_segment(int slot) {
+    const VRuntimeSegment *g = &vruntime_open[slot];
+    if (g->end > g->start) trace_counter(g->pid, g->end, (double)segment_end_value(g) / VRUNTIME_SCALE);
+    if (vruntime_open_index[slot] >= 0) vruntime_log[vruntime_open_index[slot]] = *g;
+    vruntime_open_mask &= ~(1ULL << slot);
+}
+
+// Called on every executed tick; only a point off the open segment's line
+// (a new dispatch, or a changed rate) costs a record
+void add_vruntime_log(int real_time, int pid, int64_t vruntime) {
+    int slot = pid & (VRUNTIME_OPEN_SLOTS - 1);
+    VRuntimeSegment *g = &vruntime_open[slot];
+    bool open = (vruntime_open_mask >> slot) & 1;
+    if (open && g->pid == pid && g->end == real_time - 1) {
+        int64_t delta = vruntime - segment_end_value(g);
+        if (g->end == g->start && delta >= 0) g->rate = delta;
+        if (delta == g->rate) {
+            g->end = real_time;
+            return;
+        }
     }
+
+    if (open) close_segment(slot);
+    vruntime_open_mask |= 1ULL << slot;
+    vruntime_open_index[slot] = (vruntime_log_count < MAX_VRUNTIME_LOGS) ? vruntime_log_count++ : -1;
+    g->pid = pid;
+    g->start = real_time;
+    g->end = real_time;
+    g->vruntime = vruntime;
+    g->rate = 0;
+    trace_counter(pid, real_time, (double)vruntime / VRUNTIME_SCALE);
+}
+
+// Closes every open segment; runs end with this, and only then does every
+// reserved log entry hold its segment
+void vruntime_log_flush(void) {
+    for (int i = 0; i < VRUNTIME_OPEN_SLOTS; i++) {
+        if ((vruntime_open_mask >> i) & 1) close_segment(i);
+    }
+}
+
+void vruntime_log_save(VRuntimeCursor *c) {
+    c->count = vruntime_log_count;
+    c->open_mask = vruntime_open_mask;
+    memcpy(c->open, vruntime_open, sizeof(vruntime_open));
+    memcpy(c->open_index, vruntime_open_index, sizeof(vruntime_open_index));
+}
+
+void vruntime_log_restore(const VRuntimeCursor *c) {
+    vruntime_log_count = c->count;
+    vruntime_open_mask = c->open_mask;
+    memcpy(vruntime_open, c->open, sizeof(vruntime_open));
+    memcpy(vruntime_open_index, c->open_index, sizeof(vruntime_open_index));
+}
+
+THREAD_LOCAL double sim_capacity = 1.0;
+
+// --- Quiet Runs and Early Stop ---
+THREAD_LOCAL bool sim_quiet = false;
+THREAD_LOCAL bool (*sim_stop_hook)(int now) = NULL;
+
+bool sim_should_stop(int now) {
+    return sim_stop_hook != NULL && sim_stop_hook(now);
+}
+
+void sim_release_thread(void) {
+    sleepq_free();
+    arena_release(&run_arena);
+    free(progress_pending);
+    progress_pending = NULL;
+    progress_pending_count = 0;
+    progress_pending_capacity = 0;
 }
 
 // --- JSON Output Functions ---
@@ -45,13 +193,16 @@ void print_gantt_json(void) {
     printf("]\n--- GANTT_DATA_END ---\n");
 }
 
+// One record per segment; the points between start and end are on the line
 void print_vruntime_json(void) {
     printf("\n--- VRUNTIME_DATA_START ---\n[");
     for (int i = 0; i < vruntime_log_count; i++) {
-        printf("{\"time\":%d,\"pid\":%d,\"vruntime\":%.4f}%s",
-               vruntime_log[i].real_time,
-               vruntime_log[i].pid,
-               vruntime_log[i].vruntime,
+        const VRuntimeSegment *g = &vruntime_log[i];
+        printf("{\"pid\":%d,\"start\":%d,\"end\":%d,\"vruntime_start\":%.4f,\"rate\":%.4f,\"vruntime_end\":%.4f}%s",
+               g->pid, g->start, g->end,
+               (double)g->vruntime / VRUNTIME_SCALE,
+               (double)g->rate / VRUNTIME_SCALE,
+               (double)segment_end_value(g) / VRUNTIME_SCALE,
                (i < vruntime_log_count - 1) ? "," : "");
     }
     printf("]\n--- VRUNTIME_DATA_END ---\n");
@@ -68,8 +219,8 @@ double calculate_jain_fairness(Process p[], int n) {
     
     for (int i = 0; i < n; i++) {
         // Use turnaround time as allocation metric
-        // Normalized by burst time to account for different job sizes
-        double allocation = (p[i].bt > 0) ? (double)p[i].bt / (double)p[i].tat : 0.0;
+        // Normalized by burst time (plus I/O time, which no scheduler can shorten)
+        double allocation = (p[i].bt > 0) ? (double)(p[i].bt + p[i].io_time) / (double)p[i].tat : 0.0;
         sum += allocation;
         sum_sq += allocation * allocation;
     }
@@ -80,12 +231,66 @@ double calculate_jain_fairness(Process p[], int n) {
     return jain;
 }
 
+// --- Distribution Helpers ---
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile (pct in 0..100)
+double percentile(double values[], int n, double pct) {
+    if (n <= 0) return 0.0;
+    qsort(values, n, sizeof(double), compare_doubles);
+
+    int rank = (int)ceil(pct / 100.0 * n);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return values[rank - 1];
+}
+
+void compute_metrics(Process p[], int n, SimMetrics *m) {
+    double *rts = (double*)malloc(n * sizeof(double));
+    double *tats = (double*)malloc(n * sizeof(double));
+    double total_wt = 0, total_tat = 0, total_rt = 0;
+    int max_ct = 0;
+
+    for (int i = 0; i < n; i++) {
+        total_wt += p[i].wt;
+        total_tat += p[i].tat;
+        total_rt += p[i].rt;
+        rts[i] = p[i].rt;
+        tats[i] = p[i].tat;
+        if (p[i].ct > max_ct) max_ct = p[i].ct;
+    }
+
+    m->avg_wt = total_wt / n;
+    m->avg_tat = total_tat / n;
+    m->avg_rt = total_rt / n;
+    m->p99_rt = percentile(rts, n, 99.0);
+    m->p99_tat = percentile(tats, n, 99.0);
+    m->context_switches = cs_switch_count;
+    m->makespan = max_ct;
+
+    free(rts);
+    free(tats);
+}
+
 // Exact print format matching your screenshot
 void print_table(Process p[], int n, const char* algo_name) {
     float total_wt = 0, total_tat = 0, total_rt = 0;
     int max_ct = 0;
     int min_at = 100000;
 
+    if (sim_quiet) return;
+
+    // Final progress record with any segments not yet streamed
+    for (int i = 0; i < n; i++) {
+        if (p[i].ct > max_ct) max_ct = p[i].ct;
+    }
+    progress_flush(max_ct);
+    vruntime_log_flush();
+
     printf("\n--- %s Results ---\n\n", algo_name);
     printf("PID\tAT\tBT\tWT\tTAT\tRT\n"); // Tab separated as per your CFS code
 
@@ -110,9 +315,13 @@ void print_table(Process p[], int n, const char* algo_name) {
     
     float total_time = max_ct - min_at;
     if(total_time <= 0) total_time = 1;
+    float cpu_time = total_time * sim_capacity; // Capacity available over the run
 
-    // Fixed calculation to match your CFS snippet logic exactly
-    float cpu_util = (total_time > 0) ? (((float)total_burst / total_time) * 100.0) : 0.0;
+    // CPU Utilization counts every busy tick (useful work + switch overhead),
+    // Effective CPU Utilization only the ticks that advanced a process.
+    long total_overhead = cs_switch_overhead + cs_cache_overhead;
+    float cpu_util = (total_time > 0) ? (((float)(total_burst + total_overhead) / cpu_time) * 100.0) : 0.0;
+    float eff_util = (total_time > 0) ? (((float)total_burst / cpu_time) * 100.0) : 0.0;
     float throughput = (total_time > 0) ? ((float)n / total_time) : 0.0;
 
     // Calculate Jain's Fairness Index
@@ -123,9 +332,18 @@ void print_table(Process p[], int n, const char* algo_name) {
     printf("Average Turnaround Time    = %.2f\n", avg_tat);
     printf("Average Response Time      = %.2f\n", avg_rt);
     printf("CPU Utilization            = %.2f%%\n", cpu_util);
+    printf("Effective CPU Utilization  = %.2f%%\n", eff_util);
+    printf("Context Switches           = %ld\n", cs_switch_count);
+    printf("Switch Overhead            = %ld (switch %ld + cache %ld)\n",
+           total_overhead, cs_switch_overhead, cs_cache_overhead);
     printf("Throughput                 = %.2f processes/unit time\n", throughput);
     printf("Jain Fairness Index        = %.4f\n", fairness);
 
+    // Wakeup latency is only meaningful when processes have I/O phases
+    if (io_enabled) {
+        print_io_latency(p, n);
+    }
+
     // Print Gantt chart data
     print_gantt_json();
     
@@ -142,6 +360,11 @@ void reset_processes(Process p[], int n) {
         p[i].completed = false;
         p[i].queue_level = 0;
         p[i].vruntime = 0; // Reset for CFS
+        p[i].last_ran = -1;
+        io_reset_process(&p[i]);
     }
+    sleepq_reset();
+    cs_reset();
+    progress_reset(p, n);
     reset_logs(); // Also reset the logging arrays
 }
@@ -3,6 +3,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+// Fixed-point virtual runtime: one tick of nice-0 execution advances
+// vruntime by VRUNTIME_SCALE units. Integer keys give exact, reproducible
+// ordering in the CFS/EEVDF trees.
+#define VRUNTIME_SCALE (1LL << 20)
+
+// Mutable simulator state (logs, sleep queue, switch accounting, tunables)
+// is per thread, so independent runs can execute in parallel (see Tune/).
+// Configuration set once by main.c stays process-wide.
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
 
 typedef struct {
     int pid;
@@ -16,10 +31,23 @@ typedef struct {
     int period;   // For RMS
     int deadline; // For EDF (Relative)
     int abs_deadline;
+    int dl_runtime; // For EDF with CBS: budget per period
 
     // CFS Specific (ADDED)
-    double vruntime;
-    double weight;
+    int nice;                // -20..19, selects the load weight
+    int64_t vruntime;        // Fixed point, see VRUNTIME_SCALE
+    long weight;             // Load weight (1024 = nice 0)
+    uint32_t inv_weight;     // 2^32 / weight, turns divides into multiply + shift
+    struct TaskGroup *group; // Group whose runqueue holds this entity (NULL = none)
+    struct TaskGroup *my_q;  // Set only for group entities: the runqueue they own
+
+    // EEVDF Specific
+    int64_t vdeadline;       // Virtual deadline of the current request
+    int64_t vlag;            // Lag (avg_vruntime - vruntime) kept across sleeps
+
+    // Scheduling policy (see RT/rt.h)
+    int policy;              // POLICY_NORMAL (CFS), POLICY_FIFO or POLICY_RR
+    int rt_priority;         // 1..99 for FIFO/RR, higher runs first
 
     // Scheduling internal state
     int rem_bt;   // Remaining Burst Time
@@ -33,6 +61,26 @@ typedef struct {
     
     // MLFQ specific
     int queue_level; 
+
+    // CPU/IO burst model (see IO/io.h)
+    int *bursts;          // Alternating CPU/IO lengths, NULL = single CPU burst
+    int burst_count;
+    int burst_idx;        // Index of the current CPU burst in 'bursts'
+    int next_block_at;    // Executed CPU time at which the current burst ends
+    int io_time;          // Total time spent in I/O
+    bool blocked;         // Sleeping on I/O
+    int ready_since;      // Arrival or last wakeup time
+    bool wake_pending;    // Woken up, not yet dispatched
+    int wakeups;
+    long sched_lat_total; // Sum of wakeup-to-run latencies
+    int sched_lat_max;
+
+    // Context-switch cost model (see CtxSwitch/ctxswitch.h)
+    int last_ran;         // Time the process was last switched out, -1 = never ran
+
+    // Fork-join DAG (see Steal/steal.h)
+    int *deps;            // PIDs of earlier tasks this one joins on, NULL = none
+    int dep_count;
 } Process;
 
 typedef struct {
@@ -49,26 +97,90 @@ typedef struct {
 } GanttEvent;
 
 #define MAX_GANTT_EVENTS 1000
-extern GanttEvent gantt_log[MAX_GANTT_EVENTS];
-extern int gantt_log_count;
+extern THREAD_LOCAL GanttEvent gantt_log[MAX_GANTT_EVENTS];
+extern THREAD_LOCAL int gantt_log_count;
 
 // --- VRuntime Tracking (CFS-specific) ---
+// vruntime grows linearly while a task runs, so one segment covers a whole
+// run: the logged points are (t, vruntime + (t - start) * rate) for t in
+// start..end. A segment opens at dispatch and closes at preemption (the
+// next point for the task is not one tick later on the same line).
 typedef struct {
-    int real_time;
     int pid;
-    double vruntime;
-} VRuntimeLog;
+    int start;              // First logged tick
+    int end;                // Last logged tick
+    int64_t vruntime;       // At 'start'
+    int64_t rate;           // Per tick, 0 until the segment has two points
+} VRuntimeSegment;
 
+// The log is in order of segment start (entries are reserved at open, and
+// past the cap the latest segments are dropped); it is complete only after
+// vruntime_log_flush
 #define MAX_VRUNTIME_LOGS 1000
-extern VRuntimeLog vruntime_log[MAX_VRUNTIME_LOGS];
-extern int vruntime_log_count;
+extern THREAD_LOCAL VRuntimeSegment vruntime_log[MAX_VRUNTIME_LOGS];
+extern THREAD_LOCAL int vruntime_log_count;
+
+// Open segments, direct-mapped by pid; a collision just closes one early
+#define VRUNTIME_OPEN_SLOTS 64
+
+// Log state to put back after a replay (what-if checkpoints)
+typedef struct {
+    int count;
+    uint64_t open_mask;
+    VRuntimeSegment open[VRUNTIME_OPEN_SLOTS];
+    int open_index[VRUNTIME_OPEN_SLOTS];
+} VRuntimeCursor;
 
 // --- Function Declarations ---
 void print_table(Process p[], int n, const char* algo_name);
 void reset_processes(Process p[], int n);
 void reset_logs(void);
 void add_gantt_event(int pid, int start, int end);
-void add_vruntime_log(int real_time, int pid, double vruntime);
+void add_vruntime_log(int real_time, int pid, int64_t vruntime);
+void vruntime_log_flush(void);
+void vruntime_log_save(VRuntimeCursor *c);
+void vruntime_log_restore(const VRuntimeCursor *c);
 void print_gantt_json(void);
 void print_vruntime_json(void);
-double calculate_jain_fairness(Process p[], int n);
\ No newline at end of file
+double calculate_jain_fairness(Process p[], int n);
+double percentile(double values[], int n, double pct); // Sorts 'values' in place
+
+// --- Progress Streaming ---
+// With progress_interval > 0, a one-line record
+//   PROGRESS {"time":T,"completed":C,"total":N,"gantt":[...]}
+// is flushed to stdout whenever simulated time crosses another interval,
+// carrying the Gantt segments closed since the previous record. Schedulers
+// need no changes: records are driven from add_gantt_event.
+extern int progress_interval;
+void progress_reset(Process p[], int n);
+void progress_flush(int now);
+// While paused nothing is streamed (what-if replays re-run the timeline)
+void progress_pause(bool paused);
+
+// --- Quiet Runs and Early Stop ---
+// sim_quiet suppresses the banner and results table of the tunable
+// schedulers (RR, MLFQ, CFS); callers read results via compute_metrics.
+// If sim_stop_hook is set, those schedulers poll it every iteration and
+// abandon the run once it returns true.
+extern THREAD_LOCAL bool sim_quiet;
+extern THREAD_LOCAL bool (*sim_stop_hook)(int now);
+bool sim_should_stop(int now);
+void sim_release_thread(void); // Frees per-thread buffers before a worker exits
+
+// --- Multi-CPU Runs ---
+// Total CPU capacity in full-speed CPUs. Multi-CPU modes (SMP/) set it so
+// print_table reports utilization across all CPUs; 1.0 otherwise.
+extern THREAD_LOCAL double sim_capacity;
+
+// --- Run Metrics ---
+typedef struct {
+    double avg_wt;
+    double avg_tat;
+    double avg_rt;
+    double p99_rt;
+    double p99_tat;
+    long context_switches;
+    int makespan;
+} SimMetrics;
+
+void compute_metrics(Process p[], int n, SimMetrics *m);
\ No newline at end of file
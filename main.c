@@ -2,7 +2,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "common.h"
+#include "IO/io.h"
+#include "CtxSwitch/ctxswitch.h"
 
 // Include all algorithm headers
 #include "FCFS/fcfs.h"
@@ -14,6 +17,18 @@
 #include "PropShare/propshare.h"
 #include "RMS/rms.h"
 #include "CFS/cfs.h"
+#include "EEVDF/eevdf.h"
+#include "Tune/tune.h"
+#include "MonteCarlo/montecarlo.h"
+#include "Stream/stream.h"
+#include "Classes/classes.h"
+#include "Load/load.h"
+#include "RT/rt.h"
+#include "SMP/smp.h"
+#include "Steal/steal.h"
+#include "Timer/timer_wheel.h"
+#include "Trace/trace.h"
+#include "Arena/arena.h"
 
 void export_results_to_json(Process *p, int n, const char *algo_name) {
     // This path goes "up" one level from the build folder to the root
@@ -37,31 +52,326 @@ void export_results_to_json(Process *p, int n, const char *algo_name) {
     }
 }
 
+#define MAX_WHATIF 16
+
+// Parses "PID:nice:VALUE@TIME" or "PID:arrival:VALUE"
+static bool parse_whatif(const char *spec, WhatIfChange *c) {
+    char field[16];
+    int used = 0;
+    if (sscanf(spec, "%d:%15[a-z]:%d%n", &c->pid, field, &c->value, &used) != 3) return false;
+
+    c->time = 0;
+    if (strcmp(field, "nice") == 0) {
+        c->field = WHATIF_NICE;
+        if (spec[used] == '@') c->time = atoi(spec + used + 1);
+        if (c->value < -20) c->value = -20;
+        if (c->value > 19) c->value = 19;
+    } else if (strcmp(field, "arrival") == 0) {
+        c->field = WHATIF_ARRIVAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 int main(int argc, char *argv[]) {
     // If running via command line arg
+    // Usage: scheduler [choice] [--io] [--groups] [--nice] [--cs-cost N] [--cache-penalty N] [--cache-decay N]
+    //                  [--checkpoint N] [--whatif SPEC]... [--progress N]
+    //                  [--mlfq-quantum N] [--sched-latency N] [--min-granularity N]
+    //                  [--tune] [--objective NAME] [--switch-budget N] [--threads N]
+    //                  [--seed N] [--replicas N] [--ci-tol X] [--stream] [--stream-out FILE] [--classes]
+    //                  [--load-sweep] [--loads LIST] [--sweep-tasks N] [--warmup N]
+    //                  [--rt] [--rt-runtime N] [--rt-period N] [--rt-timeslice N]
+    //                  [--cpus SPEC] [--balance-interval N] [--topology FILE] [--pdes] [--cbs]
+    //                  [--workers N] [--steal-cost N]
+    //                  [--bench-timers N] [--trace FILE] [--arena-size KB] [--arena-stats]
+    //   --io            : each process is followed by its I/O phases (alternating I/O and CPU bursts)
+    //   --groups        : CFS only, read a task group hierarchy and a group per process
+    //   --nice          : CFS/EEVDF read a nice value (-20..19) instead of priority 0-9
+    //   --cs-cost       : ticks charged per context switch
+    //   --cache-penalty : ticks to refill a cold cache after running other tasks
+    //   --cache-decay   : time constant (ticks) of cache warmth decay
+    //   --checkpoint    : CFS what-if runs snapshot state every N ticks (default 50)
+    //   --whatif        : CFS only, re-simulate with one change, e.g. 3:nice:-5@40 or 3:arrival:12
+    //   --progress      : flush a PROGRESS record (time, completed, new Gantt segments) every N ticks
+    //   --mlfq-quantum, --sched-latency, --min-granularity : override scheduler tunables
+    //   --tune          : RR/MLFQ/CFS, search the tunables and report the Pareto front
+    //   --objective     : p99_rt (default), avg_rt, avg_wt, avg_tat or p99_tat
+    //   --switch-budget : maximum context switches for a tuning candidate (0 = unlimited)
+    //   --threads       : tuning / Monte Carlo / load sweep / --pdes worker threads (default: one per CPU)
+    //   --seed          : Prop Share lottery / work-stealing victim seed (default: from the clock)
+    //   --replicas      : Prop Share, run up to N seeded replicas and report 95% confidence intervals
+    //   --ci-tol        : stop replicas once every interval is within this fraction of its mean (default 0.02)
+    //   --stream        : FCFS/Priority/SJF/RR, read arrival-sorted processes lazily and keep only active ones
+    //   --stream-out    : write streamed per-process results to FILE instead of stdout
+    //   --classes       : FCFS/RR, read task classes (count, burst, arrival generator) instead of processes
+    //   --load-sweep    : use the processes as a task mix for open Poisson arrivals and report latency vs load
+    //   --loads         : load points in percent, e.g. 50,80,90,99 (default 10..90, 95, 99)
+    //   --sweep-tasks   : measured tasks per load point (default 2000)
+    //   --warmup        : tasks discarded before (and kept arriving after) the measured ones (default 1/5)
+    //   --rt            : CFS only, every process also reads a policy (CFS, FIFO, RR) and RT priority
+    //   --rt-runtime, --rt-period : RT bandwidth, RT tasks may run N of every M ticks (-1 = unlimited)
+    //   --rt-timeslice  : SCHED_RR quantum in ticks
+    //   --cpus          : CFS only, simulate CPUs of these capacities, e.g. 2x1024,4x512 (1024 = full speed)
+    //   --balance-interval : ticks between misfit migration / load balancing passes (default 4)
+    //   --topology      : CFS only, CPUs with SMT/LLC/NUMA topology and migration costs from FILE (see SMP/smp.h)
+    //   --pdes          : with --cpus/--topology, run groups of simulated CPUs on --threads host threads
+    //   --cbs           : EDF only, every process also reads a runtime and period (SCHED_DEADLINE reservation)
+    //   --workers       : work stealing (11), runtime worker threads (default 4)
+    //   --steal-cost    : work stealing, ticks per steal attempt (default 1)
+    //   --bench-timers  : time the timing wheel against a binary heap with 10k..N pending timers, then exit
+    //   --trace         : stream the timeline to FILE, Chrome JSON if it ends in .json, else Perfetto protobuf
+    //   --arena-size    : first block of each run arena in KB (default 64), e.g. a previous run's peak
+    //   --arena-stats   : report the peak run arena usage across all runs and threads
     int choice = 0;
-    if (argc >= 2) {
-        choice = atoi(argv[1]);
-    } else {
+    bool choice_from_args = false;
+    bool group_mode = false;
+    bool nice_mode = false;
+    int checkpoint_interval = WHATIF_DEFAULT_INTERVAL;
+    WhatIfChange whatifs[MAX_WHATIF];
+    int whatif_count = 0;
+    bool tune_mode = false;
+    TuneConfig tune_cfg = { OBJ_P99_RT, 0, 0 };
+    MonteCarloConfig mc_cfg = { 0, 0.02, 0, 0 };
+    bool stream_mode = false;
+    const char *stream_out = NULL;
+    bool class_mode = false;
+    LoadConfig load_cfg = { false, { 0 }, 0, 0, -1, 0, 0 };
+    bool rt_mode = false;
+    SmpConfig smp_cfg = { .balance_interval = SMP_DEFAULT_BALANCE_INTERVAL };
+    const char *topology_path = NULL;
+    bool cbs_mode = false;
+    bool pdes_mode = false;
+    StealConfig steal_cfg = { STEAL_DEFAULT_WORKERS, STEAL_DEFAULT_COST };
+    int bench_timers = 0;
+    const char *trace_path = NULL;
+    bool arena_stats = false;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--io") == 0) {
+            io_enabled = true;
+        } else if (strcmp(argv[a], "--groups") == 0) {
+            group_mode = true;
+        } else if (strcmp(argv[a], "--nice") == 0) {
+            nice_mode = true;
+        } else if (strcmp(argv[a], "--cs-cost") == 0 && a + 1 < argc) {
+            cs_switch_cost = atoi(argv[++a]);
+            if (cs_switch_cost < 0) cs_switch_cost = 0;
+        } else if (strcmp(argv[a], "--cache-penalty") == 0 && a + 1 < argc) {
+            cs_cache_penalty = atoi(argv[++a]);
+            if (cs_cache_penalty < 0) cs_cache_penalty = 0;
+        } else if (strcmp(argv[a], "--cache-decay") == 0 && a + 1 < argc) {
+            cs_cache_decay = atoi(argv[++a]);
+            if (cs_cache_decay < 0) cs_cache_decay = 0;
+        } else if (strcmp(argv[a], "--mlfq-quantum") == 0 && a + 1 < argc) {
+            mlfq_quantum = atoi(argv[++a]);
+            if (mlfq_quantum < 1) mlfq_quantum = 1;
+        } else if (strcmp(argv[a], "--sched-latency") == 0 && a + 1 < argc) {
+            sched_latency = atoi(argv[++a]);
+            if (sched_latency < 1) sched_latency = 1;
+        } else if (strcmp(argv[a], "--min-granularity") == 0 && a + 1 < argc) {
+            sched_min_granularity = atoi(argv[++a]);
+            if (sched_min_granularity < 1) sched_min_granularity = 1;
+        } else if (strcmp(argv[a], "--tune") == 0) {
+            tune_mode = true;
+        } else if (strcmp(argv[a], "--objective") == 0 && a + 1 < argc) {
+            a++;
+            if (!tune_parse_objective(argv[a], &tune_cfg.objective)) {
+                printf("Unknown objective '%s', using p99_rt\n", argv[a]);
+            }
+        } else if (strcmp(argv[a], "--switch-budget") == 0 && a + 1 < argc) {
+            tune_cfg.switch_budget = atol(argv[++a]);
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            tune_cfg.threads = atoi(argv[++a]);
+            mc_cfg.threads = tune_cfg.threads;
+            load_cfg.threads = tune_cfg.threads;
+        } else if (strcmp(argv[a], "--seed") == 0 && a + 1 < argc) {
+            lottery_seed = strtoull(argv[++a], NULL, 10);
+            mc_cfg.seed = lottery_seed;
+            load_cfg.seed = lottery_seed;
+        } else if (strcmp(argv[a], "--replicas") == 0 && a + 1 < argc) {
+            mc_cfg.max_replicas = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--ci-tol") == 0 && a + 1 < argc) {
+            mc_cfg.ci_tol = atof(argv[++a]);
+        } else if (strcmp(argv[a], "--stream") == 0) {
+            stream_mode = true;
+        } else if (strcmp(argv[a], "--classes") == 0) {
+            class_mode = true;
+        } else if (strcmp(argv[a], "--load-sweep") == 0) {
+            load_cfg.enabled = true;
+        } else if (strcmp(argv[a], "--loads") == 0 && a + 1 < argc) {
+            a++;
+            if (!load_parse_points(argv[a], &load_cfg)) printf("Ignoring load points '%s'\n", argv[a]);
+        } else if (strcmp(argv[a], "--sweep-tasks") == 0 && a + 1 < argc) {
+            load_cfg.tasks = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--warmup") == 0 && a + 1 < argc) {
+            load_cfg.warmup = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--stream-out") == 0 && a + 1 < argc) {
+            stream_out = argv[++a];
+        } else if (strcmp(argv[a], "--rt") == 0) {
+            rt_mode = true;
+        } else if (strcmp(argv[a], "--rt-runtime") == 0 && a + 1 < argc) {
+            rt_runtime = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--rt-period") == 0 && a + 1 < argc) {
+            rt_period = atoi(argv[++a]);
+            if (rt_period < 1) rt_period = 1;
+        } else if (strcmp(argv[a], "--rt-timeslice") == 0 && a + 1 < argc) {
+            rt_timeslice = atoi(argv[++a]);
+            if (rt_timeslice < 1) rt_timeslice = 1;
+        } else if (strcmp(argv[a], "--cpus") == 0 && a + 1 < argc) {
+            a++;
+            if (!smp_parse_cpus(argv[a], &smp_cfg)) {
+                printf("Ignoring CPU list '%s'\n", argv[a]);
+                smp_cfg.cpu_count = 0;
+            }
+        } else if (strcmp(argv[a], "--topology") == 0 && a + 1 < argc) {
+            topology_path = argv[++a];
+        } else if (strcmp(argv[a], "--balance-interval") == 0 && a + 1 < argc) {
+            smp_cfg.balance_interval = atoi(argv[++a]);
+            if (smp_cfg.balance_interval < 1) smp_cfg.balance_interval = 1;
+        } else if (strcmp(argv[a], "--pdes") == 0) {
+            pdes_mode = true;
+        } else if (strcmp(argv[a], "--workers") == 0 && a + 1 < argc) {
+            steal_cfg.workers = atoi(argv[++a]);
+            if (steal_cfg.workers < 1) steal_cfg.workers = 1;
+            if (steal_cfg.workers > STEAL_MAX_WORKERS) steal_cfg.workers = STEAL_MAX_WORKERS;
+        } else if (strcmp(argv[a], "--steal-cost") == 0 && a + 1 < argc) {
+            steal_cfg.steal_cost = atoi(argv[++a]);
+            if (steal_cfg.steal_cost < 0) steal_cfg.steal_cost = 0;
+        } else if (strcmp(argv[a], "--cbs") == 0) {
+            cbs_mode = true;
+        } else if (strcmp(argv[a], "--bench-timers") == 0 && a + 1 < argc) {
+            bench_timers = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--trace") == 0 && a + 1 < argc) {
+            trace_path = argv[++a];
+        } else if (strcmp(argv[a], "--arena-size") == 0 && a + 1 < argc) {
+            int kb = atoi(argv[++a]);
+            if (kb > 0) arena_block_size = (size_t)kb * 1024;
+        } else if (strcmp(argv[a], "--arena-stats") == 0) {
+            arena_stats = true;
+        } else if (strcmp(argv[a], "--progress") == 0 && a + 1 < argc) {
+            progress_interval = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--checkpoint") == 0 && a + 1 < argc) {
+            checkpoint_interval = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--whatif") == 0 && a + 1 < argc) {
+            a++;
+            if (whatif_count < MAX_WHATIF && parse_whatif(argv[a], &whatifs[whatif_count])) {
+                whatif_count++;
+            } else {
+                printf("Ignoring what-if '%s'\n", argv[a]);
+            }
+        } else {
+            choice = atoi(argv[a]);
+            choice_from_args = true;
+        }
+    }
+
+    // A topology file describes the CPUs itself and takes precedence over --cpus
+    if (topology_path != NULL && !smp_load_topology(topology_path, &smp_cfg)) return 1;
+    smp_cfg.pdes = pdes_mode;
+    smp_cfg.threads = tune_cfg.threads;
+
+    if (bench_timers > 0) {
+        run_timer_bench(bench_timers);
+        return 0;
+    }
+
+    if (!choice_from_args) {
         printf("Select Algorithm:\n");
-        printf("1: FCFS\n2: Priority\n3: SJF (SRTF)\n4: RR\n5: MLFQ\n6: EDF\n7: Prop Share\n8: RMS\n9: CFS\n");
+        printf("1: FCFS\n2: Priority\n3: SJF (SRTF)\n4: RR\n5: MLFQ\n6: EDF\n7: Prop Share\n8: RMS\n9: CFS\n10: EEVDF\n11: Work Stealing\n");
         printf("Enter Choice: ");
         scanf("%d", &choice);
     }
 
+    // Task classes: identical tasks are described once per class and never
+    // expanded into a task table
+    if (class_mode) {
+        int class_count = 0;
+        int time_quantum = 2;
+        printf("Number of Task Classes: ");
+        scanf("%d", &class_count);
+        if (class_count < 0) class_count = 0;
+        if (class_count > MAX_TASK_CLASSES) class_count = MAX_TASK_CLASSES;
+        if (choice == 4) {
+            printf("Enter Time Quantum: ");
+            scanf("%d", &time_quantum);
+        }
+
+        TaskClass classes[MAX_TASK_CLASSES];
+        for (int c = 0; c < class_count; c++) {
+            TaskClass *tc = &classes[c];
+            printf("\nClass %d Task Count: ", c + 1);
+            scanf("%ld", &tc->count);
+            printf("Burst Time: ");
+            scanf("%d", &tc->bt);
+            printf("First Arrival: ");
+            scanf("%d", &tc->first_at);
+            printf("Arrival Gap (0 = all at once): ");
+            scanf("%d", &tc->gap);
+            printf("Tasks per Arrival: ");
+            scanf("%ld", &tc->per_arrival);
+            if (tc->count < 0) tc->count = 0;
+            if (tc->bt < 1) tc->bt = 1;
+            if (tc->first_at < 0) tc->first_at = 0;
+            if (tc->gap < 0) tc->gap = 0;
+            if (tc->per_arrival < 1) tc->per_arrival = 1;
+        }
+        return run_classes(choice, classes, class_count, time_quantum) ? 0 : 1;
+    }
+
     int n;
     printf("Enter Total Number of Processes: ");
     scanf("%d", &n);
 
-    Process *p = (Process*)malloc(n * sizeof(Process));
-
     // If Algorithm is RR (4), ask for Time Quantum
     int time_quantum = 2; // Default
     if (choice == 4) {
-        if (argc < 2) printf("Enter Time Quantum: ");
+        if (!choice_from_args) printf("Enter Time Quantum: ");
         scanf("%d", &time_quantum);
     }
 
+    // Streaming: processes are read by the simulator itself, never all at once
+    if (stream_mode) {
+        FILE *sink = stdout;
+        if (stream_out != NULL && (sink = fopen(stream_out, "w")) == NULL) {
+            printf("Cannot open '%s' for writing\n", stream_out);
+            return 1;
+        }
+        bool ok = run_stream(choice, n, time_quantum, stdin, sink);
+        if (sink != stdout) fclose(sink);
+        return ok ? 0 : 1;
+    }
+
+    // The task table and everything the run builds on it live in the run arena
+    Process *p = (Process*)arena_alloc(&run_arena, n * sizeof(Process));
+
+    // CFS group hierarchy: group 0 is the root, every other group names an
+    // earlier group as its parent.
+    TaskGroup *groups = NULL;
+    int group_count = 0;
+    if (choice == 9 && group_mode) {
+        printf("Number of Task Groups: ");
+        scanf("%d", &group_count);
+        if (group_count < 0) group_count = 0;
+        group_count++; // Plus the root group
+
+        groups = (TaskGroup*)arena_calloc(&run_arena, group_count, sizeof(TaskGroup));
+        groups[0].id = 0;
+        groups[0].shares = 1024;
+        groups[0].parent = NULL;
+        for (int g = 1; g < group_count; g++) {
+            int parent = 0;
+            groups[g].id = g;
+            printf("\nGroup %d Parent (0 = root): ", g);
+            scanf("%d", &parent);
+            printf("Group %d cpu.shares: ", g);
+            scanf("%d", &groups[g].shares);
+            if (parent < 0 || parent >= g) parent = 0;
+            if (groups[g].shares <= 0) groups[g].shares = 1024;
+            groups[g].parent = &groups[parent];
+        }
+    }
+
     for(int i=0; i<n; i++) {
         p[i].pid = i + 1;
         printf("\nEnter Details for Process %d:\n", p[i].pid);
@@ -77,21 +387,66 @@ int main(int argc, char *argv[]) {
         // ID 2: Priority
         // ID 7: PropShare (uses priority as tickets)
         // ID 9: CFS (uses priority for weight)
-        if (choice == 2 || choice == 9) {
+        // ID 10: EEVDF (same weights as CFS)
+        if ((choice == 9 || choice == 10) && nice_mode) {
+            // Full nice range for the fair schedulers
+            printf("Nice (-20..19): ");
+            scanf("%d", &p[i].nice);
+            p[i].priority = 0; // Unused by the fair schedulers
+        } else if (choice == 2 || choice == 9 || choice == 10) {
             printf("Priority (0-9): ");
             scanf("%d", &p[i].priority);
+            p[i].nice = prio_to_nice(p[i].priority);
         } else {
             // For algorithms that don't use priority (FCFS, SJF, RR, MLFQ, EDF, RMS)
             // default it to 0 so the struct is clean.
             p[i].priority = 0; 
+            p[i].nice = 0;
+        }
+
+        // Scheduling policy: RT tasks run ahead of every CFS task
+        p[i].policy = POLICY_NORMAL;
+        p[i].rt_priority = 0;
+        if (choice == 9 && rt_mode) {
+            printf("Policy (0 = CFS, 1 = FIFO, 2 = RR): ");
+            scanf("%d", &p[i].policy);
+            if (p[i].policy < POLICY_NORMAL || p[i].policy > POLICY_RR) p[i].policy = POLICY_NORMAL;
+            if (p[i].policy != POLICY_NORMAL) {
+                printf("RT Priority (1-99): ");
+                scanf("%d", &p[i].rt_priority);
+                if (p[i].rt_priority < 1) p[i].rt_priority = 1;
+                if (p[i].rt_priority >= RT_MAX_PRIO) p[i].rt_priority = RT_MAX_PRIO - 1;
+            }
+        }
+
+        p[i].group = NULL;
+        p[i].my_q = NULL;
+        if (groups != NULL) {
+            int g = 0;
+            printf("Group (0 = root): ");
+            scanf("%d", &g);
+            if (g < 0 || g >= group_count) g = 0;
+            p[i].group = &groups[g];
         }
 
         // Init optional fields
         p[i].deadline = 0;
         p[i].period = 0;
+        p[i].dl_runtime = 0;
         p[i].tickets = 0; 
         
-        if(choice == 6) { // EDF
+        if(choice == 6 && cbs_mode) { // EDF with CBS: runtime <= deadline <= period
+            printf("Runtime: ");
+            scanf("%d", &p[i].dl_runtime);
+            printf("Relative Deadline: ");
+            scanf("%d", &p[i].deadline);
+            printf("Period (0 = deadline): ");
+            scanf("%d", &p[i].period);
+            if (p[i].dl_runtime < 1) p[i].dl_runtime = 1;
+            if (p[i].deadline < p[i].dl_runtime) p[i].deadline = p[i].dl_runtime;
+            if (p[i].period < p[i].deadline) p[i].period = p[i].deadline;
+        }
+        else if(choice == 6) { // EDF
             printf("Relative Deadline: ");
             scanf("%d", &p[i].deadline);
         }
@@ -109,6 +464,51 @@ int main(int argc, char *argv[]) {
             printf("Period: ");
             scanf("%d", &p[i].period);
         }
+
+        // Work stealing: the task joins on earlier tasks and is forked when
+        // the last of them completes
+        p[i].deps = NULL;
+        p[i].dep_count = 0;
+        if (choice == 11) {
+            int count = 0;
+            printf("Dependencies: ");
+            scanf("%d", &count);
+            if (count > 0) {
+                p[i].deps = (int*)arena_alloc(&run_arena, count * sizeof(int));
+                for (int k = 0; k < count; k++) {
+                    int dep = 0;
+                    printf("Depends On (PID): ");
+                    scanf("%d", &dep);
+                    if (dep >= 1 && dep < p[i].pid) p[i].deps[p[i].dep_count++] = dep;
+                }
+            }
+        }
+
+        // I/O phases: "Burst Time" above is the first CPU burst, each phase
+        // adds an I/O wait followed by another CPU burst.
+        p[i].bursts = NULL;
+        p[i].burst_count = 1;
+        p[i].io_time = 0;
+        if (io_enabled) {
+            int phases = 0;
+            printf("I/O Phases: ");
+            scanf("%d", &phases);
+            if (phases > 0) {
+                p[i].burst_count = 2 * phases + 1;
+                p[i].bursts = (int*)arena_alloc(&run_arena, p[i].burst_count * sizeof(int));
+                p[i].bursts[0] = p[i].bt;
+                for (int k = 0; k < phases; k++) {
+                    printf("I/O Time: ");
+                    scanf("%d", &p[i].bursts[2 * k + 1]);
+                    if (p[i].bursts[2 * k + 1] < 0) p[i].bursts[2 * k + 1] = 0;
+                    printf("CPU Burst: ");
+                    scanf("%d", &p[i].bursts[2 * k + 2]);
+                    if (p[i].bursts[2 * k + 2] < 1) p[i].bursts[2 * k + 2] = 1;
+                    p[i].io_time += p[i].bursts[2 * k + 1];
+                    p[i].bt += p[i].bursts[2 * k + 2];
+                }
+            }
+        }
         
         // Initialize common fields
         p[i].rem_bt = p[i].bt;
@@ -118,25 +518,54 @@ int main(int argc, char *argv[]) {
         p[i].vruntime = 0;
     }
 
-    switch(choice) {
+    // A load sweep generates its own workloads from the entered mix
+    if (load_cfg.enabled) {
+        bool ok = run_load_sweep(choice, p, n, time_quantum, load_cfg);
+        if (arena_stats) arena_report();
+        arena_release(&run_arena);
+        return ok ? 0 : 1;
+    }
+
+    if (trace_path != NULL && !trace_open(trace_path)) printf("Cannot open trace '%s', not tracing\n", trace_path);
+
+    // The tuner and Monte Carlo mode re-run one configuration themselves;
+    // other algorithms run as usual
+    bool tuned = tune_mode && groups == NULL && !rt_mode && smp_cfg.cpu_count == 0 &&
+                 run_tuner(choice, p, n, tune_cfg);
+    if (!tuned && mc_cfg.max_replicas > 0) tuned = run_montecarlo(choice, p, n, mc_cfg);
+
+    if (!tuned) switch(choice) {
         case 1: run_fcfs(p, n); break;
         case 2: run_priority(p, n); break;
         case 3: run_sjf(p, n); break;
         case 4: run_rr(p, n, time_quantum); break;
         case 5: run_mlfq(p, n); break;
-        case 6: run_edf(p, n); break;
+        case 6:
+            if (cbs_mode) run_edf_cbs(p, n);
+            else run_edf(p, n);
+            break;
         case 7: run_propshare(p, n); break;
         case 8: run_rms(p, n); break;
-        case 9: run_cfs(p, n); break;
+        case 9:
+            if (groups != NULL) run_cfs_group(p, n, groups, group_count);
+            else if (smp_cfg.cpu_count > 0) run_smp(p, n, &smp_cfg);
+            else if (rt_mode) run_cfs_rt(p, n);
+            else if (whatif_count > 0) run_cfs_whatif(p, n, checkpoint_interval, whatifs, whatif_count);
+            else run_cfs(p, n);
+            break;
+        case 10: run_eevdf(p, n); break;
+        case 11: run_steal(p, n, &steal_cfg); break;
         default: printf("Invalid Selection.\n");
     }
+    trace_close();
+    if (arena_stats) arena_report();
 
-    char* algo_names[] = {"None", "FCFS", "Priority", "SJF", "RR", "MLFQ", "EDF", "Prop Share", "RMS", "CFS"};
+    char* algo_names[] = {"None", "FCFS", "Priority", "SJF", "RR", "MLFQ", "EDF", "Prop Share", "RMS", "CFS", "EEVDF", "Work Stealing"};
     printf("\nDEBUG: Attempting to save file to simulation_output.json...\n");
-    if(choice >= 1 && choice <= 9) {
+    if(choice >= 1 && choice <= 11) {
         export_results_to_json(p, n, algo_names[choice]);
     }
     printf("DEBUG: File save operation finished.\n");
-    free(p);
+    arena_release(&run_arena);
     return 0;
 }
\ No newline at end of file
@@ -2,7 +2,10 @@ import os
 import subprocess
 import re
 import platform
-from flask import Flask, render_template, request, jsonify
+from flask import Flask, Response, render_template, request, jsonify
+from result_cache import ResultCache, cache_key
+from jobs import JobManager
+import libscheduler
 
 app = Flask(__name__)
 
@@ -17,10 +20,28 @@ else:
 
 print(f"Creating server. Expecting C executable at: {EXECUTABLE_PATH}")
 
+# In-process simulator: /api/simulate calls libscheduler directly when the
+# shared library is built (SCHED_LIBRARY overrides its path) and falls back
+# to piping the CLI otherwise. Jobs always use the CLI for its progress stream.
+LIBRARY_PATH = os.environ.get('SCHED_LIBRARY') or libscheduler.default_library_path(C_PROJECT_ROOT)
+try:
+    LIBRARY = libscheduler.Library(LIBRARY_PATH)
+    print(f"Running simulations in-process with {LIBRARY_PATH}")
+except OSError:
+    LIBRARY = None
+
+# Results cache: identical (algorithm, parameters, workload) requests are
+# served without spawning the simulator. SCHED_CACHE_MB bounds the memory
+# tier; SCHED_CACHE_DIR enables the on-disk tier.
+RESULT_CACHE = ResultCache(
+    max_bytes=int(os.environ.get('SCHED_CACHE_MB', '64')) * 1024 * 1024,
+    disk_dir=os.environ.get('SCHED_CACHE_DIR') or None
+)
+
 # Map algorithm names to their IDs in the C program
 ALGO_MAP = {
     'fcfs': 1, 'priority': 2, 'sjf': 3, 'rr': 4, 'mlfq': 5,
-    'edf': 6, 'propshare': 7, 'rms': 8, 'cfs': 9
+    'edf': 6, 'propshare': 7, 'rms': 8, 'cfs': 9, 'eevdf': 10
 }
 
 @app.route('/')
@@ -32,7 +53,7 @@ def index():
 @app.route('/algorithm/<algo_name>')
 def algorithm_page(algo_name):
     """Serves individual algorithm detail pages."""
-    valid_algos = ['cfs', 'fcfs', 'rr', 'sjf', 'priority', 'mlfq', 'edf', 'rms', 'propshare']
+    valid_algos = ['cfs', 'eevdf', 'fcfs', 'rr', 'sjf', 'priority', 'mlfq', 'edf', 'rms', 'propshare']
     if algo_name.lower() in valid_algos:
         return render_template(f'{algo_name.lower()}.html')
     return render_template('index.html')  # Fallback to main page
@@ -118,8 +139,14 @@ def parse_c_output(output_text):
                 averages['avg_tat'] = line.split('=')[1].strip()
             elif 'Average Response Time' in line:
                 averages['avg_rt'] = line.split('=')[1].strip()
+            elif 'Effective CPU Utilization' in line:
+                averages['effective_cpu_util'] = line.split('=')[1].strip()
             elif 'CPU Utilization' in line:
                 averages['cpu_util'] = line.split('=')[1].strip()
+            elif 'Context Switches' in line:
+                averages['context_switches'] = line.split('=')[1].strip()
+            elif 'Switch Overhead' in line:
+                averages['switch_overhead'] = line.split('=')[1].strip()
             elif 'Throughput' in line:
                 averages['throughput'] = line.split('=')[1].strip()
             elif 'Jain Fairness Index' in line:
@@ -133,17 +160,22 @@ def parse_c_output(output_text):
     }
 
 
-@app.route('/api/simulate', methods=['POST'])
-def simulate():
-    if not os.path.exists(EXECUTABLE_PATH):
-        return jsonify({'error': f"Executable not found at {EXECUTABLE_PATH}"}), 500
-
-    data = request.json
+def build_simulation_input(data):
+    """Turns a dashboard request into (argv, stdin) for the C program.
+    Raises ValueError for workloads that cannot run to completion."""
     # Default to 1 (FCFS) if missing
     algo_id = ALGO_MAP.get(data.get('algorithm'), 1) 
     processes = data.get('processes', [])
 
-    # --- 1. Construct Input String ---
+    # A zero burst never completes under some algorithms, and runs are not
+    # time-limited by default: reject it rather than spin until cancelled
+    try:
+        invalid = any(int(p['burst']) < 1 or int(p['arrival']) < 0 for p in processes)
+    except (ValueError, KeyError, TypeError):
+        raise ValueError("Every process needs an integer arrival and burst time.")
+    if invalid:
+        raise ValueError("Burst times must be at least 1 and arrival times non-negative.")
+
     # The order MUST match the scanf calls in the C main function exactly.
     input_str = f"{len(processes)}\n"
 
@@ -158,8 +190,8 @@ def simulate():
         line = f"{p['arrival']} {p['burst']}"
         
         # 2. Priority is OPTIONAL in C.
-        # Only append it if algo is Priority(2), or CFS(9).
-        if algo_id in [2, 9]:
+        # Only append it if algo is Priority(2), CFS(9) or EEVDF(10).
+        if algo_id in [2, 9, 10]:
             line += f" {p['priority']}"
         
         # 3. Extra Parameters (Deadline, Period or Tickets)
@@ -174,10 +206,63 @@ def simulate():
         
         input_str += line + "\n"
 
+    args = [str(algo_id)] # Pass algo_id as argument
+    return args, input_str
+
+
+def simulate_in_process(data):
+    """/api/simulate through libscheduler: same cache, same response."""
+    try:
+        args, input_str = build_simulation_input(data)
+    except ValueError as e:
+        return jsonify({'error': str(e)}), 400
+    key = cache_key(LIBRARY_PATH, args, input_str)
+    cached = RESULT_CACHE.get(key)
+    if cached is not None:
+        response = jsonify(cached)
+        response.headers['X-Cache'] = 'HIT'
+        return response
+
+    processes = data.get('processes', [])
+    if not processes:
+        return jsonify({'error': "Simulation ran but produced no valid output table."}), 500
     try:
-        # --- 2. Run C Executable ---
+        parsed_results = libscheduler.simulate_dashboard(LIBRARY, ALGO_MAP.get(data.get('algorithm'), 1), processes)
+    except (ValueError, KeyError) as e:
+        return jsonify({'error': f"Simulation failed: {e}"}), 400
+
+    RESULT_CACHE.put(key, parsed_results)
+    response = jsonify(parsed_results)
+    response.headers['X-Cache'] = 'MISS'
+    return response
+
+
+@app.route('/api/simulate', methods=['POST'])
+def simulate():
+    if LIBRARY is not None:
+        return simulate_in_process(request.json)
+
+    if not os.path.exists(EXECUTABLE_PATH):
+        return jsonify({'error': f"Executable not found at {EXECUTABLE_PATH}"}), 500
+
+    # --- 1. Construct Input String ---
+    try:
+        args, input_str = build_simulation_input(request.json)
+    except ValueError as e:
+        return jsonify({'error': str(e)}), 400
+
+    # --- 2. Serve from Cache ---
+    key = cache_key(EXECUTABLE_PATH, args, input_str)
+    cached = RESULT_CACHE.get(key)
+    if cached is not None:
+        response = jsonify(cached)
+        response.headers['X-Cache'] = 'HIT'
+        return response
+
+    try:
+        # --- 3. Run C Executable ---
         process = subprocess.Popen(
-            [EXECUTABLE_PATH, str(algo_id)], # Pass algo_id as argument
+            [EXECUTABLE_PATH] + args,
             stdin=subprocess.PIPE,
             stdout=subprocess.PIPE,
             stderr=subprocess.PIPE,
@@ -192,7 +277,7 @@ def simulate():
         if process.returncode != 0:
             return jsonify({'error': f"Simulation Crashed (Code {process.returncode}): {stderr_data}"}), 400
 
-        # --- 3. Parse Output ---
+        # --- 4. Parse Output ---
         parsed_results = parse_c_output(stdout_data)
         
         # If parsing failed (empty results), return the raw stdout for debugging
@@ -200,15 +285,96 @@ def simulate():
             print("DEBUG: Raw C Output:", stdout_data)
             return jsonify({'error': "Simulation ran but produced no valid output table."}), 500
 
-        return jsonify(parsed_results)
+        # Only successful runs are cached; errors are always retried
+        RESULT_CACHE.put(key, parsed_results)
+        response = jsonify(parsed_results)
+        response.headers['X-Cache'] = 'MISS'
+        return response
 
     except subprocess.TimeoutExpired:
         process.kill()
         return jsonify({'error': "Simulation Timed Out. Input mismatch likely."}), 504
     except Exception as e:
         return jsonify({'error': str(e)}), 500
-        return jsonify({'error': str(e)}), 500
+
+@app.route('/api/cache', methods=['GET'])
+def cache_stats():
+    """Reports result cache occupancy and hit rates."""
+    return jsonify(RESULT_CACHE.stats())
+
+# --- Asynchronous Jobs ---
+# Long simulations run on a local worker pool instead of inside the request.
+# SCHED_JOB_WORKERS sizes the pool; SCHED_JOB_TIMEOUT (seconds, 0 = none)
+# bounds a single run. Runaway jobs are cancelled with DELETE instead.
+JOBS = JobManager(
+    EXECUTABLE_PATH, parse_c_output, RESULT_CACHE,
+    max_workers=int(os.environ.get('SCHED_JOB_WORKERS', '0')) or None,
+    timeout=int(os.environ.get('SCHED_JOB_TIMEOUT', '0'))
+)
+
+# Roughly this many progress records per run, whatever the workload size
+PROGRESS_RECORDS = 50
+
+def progress_interval_for(data):
+    processes = data.get('processes', [])
+    horizon = sum(int(p.get('burst', 0)) for p in processes)
+    horizon += max((int(p.get('arrival', 0)) for p in processes), default=0)
+    return max(1, horizon // PROGRESS_RECORDS)
+
+@app.route('/api/jobs', methods=['POST'])
+def submit_job():
+    """Queues a simulation and returns its job id immediately."""
+    if not os.path.exists(EXECUTABLE_PATH):
+        return jsonify({'error': f"Executable not found at {EXECUTABLE_PATH}"}), 500
+
+    data = request.json
+    try:
+        args, input_str = build_simulation_input(data)
+    except ValueError as e:
+        return jsonify({'error': str(e)}), 400
+    key = cache_key(EXECUTABLE_PATH, args, input_str)
+    job = JOBS.submit(args, input_str, key, progress_interval_for(data))
+    return jsonify({'job_id': job.id, 'status': job.status}), 202
+
+@app.route('/api/jobs/<job_id>', methods=['GET'])
+def poll_job(job_id):
+    """Job status, latest progress and, once done, the parsed result."""
+    job = JOBS.get(job_id)
+    if job is None:
+        return jsonify({'error': 'Unknown job'}), 404
+    return jsonify(job.snapshot())
+
+@app.route('/api/jobs/<job_id>', methods=['DELETE'])
+def cancel_job(job_id):
+    job = JOBS.cancel(job_id)
+    if job is None:
+        return jsonify({'error': 'Unknown job'}), 404
+    return jsonify({'job_id': job.id, 'status': job.status})
+
+@app.route('/api/jobs/<job_id>/events', methods=['GET'])
+def job_events(job_id):
+    """Server-sent events: 'progress' records (with new Gantt segments),
+    then one of 'done', 'failed' or 'cancelled'."""
+    job = JOBS.get(job_id)
+    if job is None:
+        return jsonify({'error': 'Unknown job'}), 404
+
+    def stream():
+        cursor = 0
+        while True:
+            events, finished = job.wait_events(cursor, timeout=15)
+            if not events and not finished:
+                yield ": keep-alive\n\n"
+                continue
+            for kind, payload in events:
+                yield f"event: {kind}\ndata: {json.dumps(payload)}\n\n"
+            cursor += len(events)
+            if finished and not job.wait_events(cursor, timeout=0)[0]:
+                break
+
+    return Response(stream(), mimetype='text/event-stream',
+                    headers={'Cache-Control': 'no-cache', 'X-Accel-Buffering': 'no'})
 
 if __name__ == '__main__':
     # Run the Flask app
-    app.run(debug=True, port=5000)
\ No newline at end of file
+    app.run(debug=True, port=5000, threaded=True)
\ No newline at end of file
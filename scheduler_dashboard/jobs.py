@@ -0,0 +1,223 @@
+import os
+import json
+import time
+import uuid
+import threading
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+# Job lifecycle: queued -> running -> done | failed | cancelled
+FINISHED_STATES = ('done', 'failed', 'cancelled')
+
+
+class Job:
+    """One simulator run plus the event log its subscribers replay.
+
+    Every state change is appended to 'events' as (kind, payload); SSE
+    clients keep a cursor into that list, so late subscribers still see
+    every progress record and the final result.
+    """
+
+    def __init__(self, args, input_str, key):
+        self.id = uuid.uuid4().hex
+        self.args = args
+        self.input_str = input_str
+        self.key = key
+        self.status = 'queued'
+        self.progress = {'time': 0, 'completed': 0, 'total': 0}
+        self.gantt = []          # Segments streamed so far
+        self.result = None
+        self.error = None
+        self.created = time.time()
+        self.finished = None
+
+        self.process = None
+        self.future = None
+        self.cancel_requested = False
+        self.events = []
+        self.cond = threading.Condition()
+
+    def publish(self, kind, payload, status=None):
+        with self.cond:
+            if status is not None:
+                self.status = status
+                if status in FINISHED_STATES:
+                    self.finished = time.time()
+            self.events.append((kind, payload))
+            self.cond.notify_all()
+
+    def is_finished(self):
+        return self.status in FINISHED_STATES
+
+    def wait_events(self, cursor, timeout):
+        """Returns (new events, finished) once something happens or timeout elapses."""
+        with self.cond:
+            if cursor >= len(self.events) and not self.is_finished():
+                self.cond.wait(timeout)
+            return self.events[cursor:], self.is_finished()
+
+    def snapshot(self):
+        with self.cond:
+            info = {
+                'job_id': self.id,
+                'status': self.status,
+                'progress': dict(self.progress),
+                'created': self.created,
+                'finished': self.finished,
+            }
+            if self.status == 'done':
+                info['result'] = self.result
+            elif self.status == 'failed':
+                info['error'] = self.error
+            else:
+                info['gantt'] = list(self.gantt)
+            return info
+
+
+class JobManager:
+    """Runs simulations on a local worker pool with streamed progress.
+
+    The simulator is started with '--progress N' and its PROGRESS records
+    are turned into 'progress' events carrying the new Gantt segments; the
+    remaining output is parsed exactly like a synchronous run.
+    """
+
+    def __init__(self, executable, parse_output, cache, max_workers=None,
+                 timeout=0, max_jobs=256):
+        self.executable = executable
+        self.parse_output = parse_output
+        self.cache = cache
+        self.timeout = timeout       # Seconds, 0 = no limit
+        self.max_jobs = max_jobs     # Finished jobs retained for polling
+        self.pool = ThreadPoolExecutor(max_workers=max_workers or os.cpu_count() or 2)
+        self.jobs = {}
+        self.lock = threading.Lock()
+
+    # --- Public API ---
+    def submit(self, args, input_str, key, progress_interval):
+        job = Job(args, input_str, key)
+        with self.lock:
+            self._prune()
+            self.jobs[job.id] = job
+
+        cached = self.cache.get(key)
+        if cached is not None:
+            job.result = cached
+            job.progress['completed'] = job.progress['total'] = len(cached.get('processes', []))
+            job.publish('done', cached, status='done')
+            return job
+
+        job.future = self.pool.submit(self._run, job, progress_interval)
+        return job
+
+    def get(self, job_id):
+        with self.lock:
+            return self.jobs.get(job_id)
+
+    def cancel(self, job_id):
+        job = self.get(job_id)
+        if job is None or job.is_finished():
+            return job
+
+        job.cancel_requested = True
+        if job.future is not None and job.future.cancel():
+            # Never started: nothing to kill
+            job.publish('cancelled', {}, status='cancelled')
+        elif job.process is not None:
+            job.process.kill()  # _run reports the cancellation
+        return job
+
+    # --- Worker ---
+    def _run(self, job, progress_interval):
+        if job.cancel_requested:
+            job.publish('cancelled', {}, status='cancelled')
+            return
+
+        try:
+            job.process = subprocess.Popen(
+                [self.executable] + job.args + ['--progress', str(progress_interval)],
+                stdin=subprocess.PIPE,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.PIPE,
+                text=True
+            )
+        except OSError as e:
+            job.error = str(e)
+            job.publish('failed', {'error': job.error}, status='failed')
+            return
+
+        job.publish('running', {}, status='running')
+
+        # Feed stdin from a separate thread: the simulator prints prompts while
+        # reading, so writing a large workload inline could fill the stdout pipe.
+        def feed():
+            try:
+                job.process.stdin.write(job.input_str)
+                job.process.stdin.close()
+            except (OSError, ValueError):
+                pass
+        threading.Thread(target=feed, daemon=True).start()
+
+        watchdog = None
+        if self.timeout > 0:
+            watchdog = threading.Timer(self.timeout, job.process.kill)
+            watchdog.start()
+
+        output = []
+        for line in job.process.stdout:
+            if line.startswith('PROGRESS '):
+                self._on_progress(job, line[len('PROGRESS '):])
+            else:
+                output.append(line)
+
+        stderr_data = job.process.stderr.read()
+        job.process.wait()
+        timed_out = watchdog is not None and not watchdog.is_alive() and not job.cancel_requested
+        if watchdog is not None:
+            watchdog.cancel()
+
+        if job.cancel_requested:
+            job.publish('cancelled', {}, status='cancelled')
+            return
+        if timed_out:
+            job.error = f"Simulation exceeded {self.timeout}s"
+            job.publish('failed', {'error': job.error}, status='failed')
+            return
+        if job.process.returncode != 0:
+            job.error = f"Simulation Crashed (Code {job.process.returncode}): {stderr_data}"
+            job.publish('failed', {'error': job.error}, status='failed')
+            return
+
+        result = self.parse_output(''.join(output))
+        if not result['processes']:
+            job.error = "Simulation ran but produced no valid output table."
+            job.publish('failed', {'error': job.error}, status='failed')
+            return
+
+        self.cache.put(job.key, result)
+        job.result = result
+        job.publish('done', result, status='done')
+
+    def _on_progress(self, job, text):
+        try:
+            record = json.loads(text)
+        except ValueError:
+            return
+        with job.cond:
+            job.progress = {
+                'time': record.get('time', 0),
+                'completed': record.get('completed', 0),
+                'total': record.get('total', 0),
+            }
+            job.gantt.extend(record.get('gantt', []))
+        job.publish('progress', record)
+
+    def _prune(self):
+        """Drops the oldest finished jobs beyond max_jobs (caller holds the lock)."""
+        finished = [j for j in self.jobs.values() if j.is_finished()]
+        excess = len(self.jobs) - self.max_jobs + 1
+        if excess <= 0:
+            return
+        finished.sort(key=lambda j: j.finished)
+        for j in finished[:excess]:
+            del self.jobs[j.id]
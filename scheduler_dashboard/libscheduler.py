@@ -0,0 +1,204 @@
+"""ctypes bindings for libscheduler (Lib/libscheduler.h).
+
+Runs simulations in-process instead of piping text through the CLI. The
+structures mirror the C header field for field; SCHEDULER_API_VERSION
+must match the library's.
+"""
+import ctypes
+import os
+import platform
+
+SCHEDULER_API_VERSION = 1
+
+SCHEDULER_OK = 0
+ERRORS = {
+    -1: 'invalid arguments or tasks',
+    -2: 'unknown algorithm',
+    -3: 'API version mismatch',
+}
+
+VRUNTIME_SCALE = float(1 << 20)
+
+
+class SchedulerTask(ctypes.Structure):
+    _fields_ = [
+        ('at', ctypes.c_int),
+        ('bt', ctypes.c_int),
+        ('priority', ctypes.c_int),
+        ('nice', ctypes.c_int),
+        ('tickets', ctypes.c_int),
+        ('deadline', ctypes.c_int),
+        ('period', ctypes.c_int),
+        ('deps', ctypes.POINTER(ctypes.c_int)),
+        ('dep_count', ctypes.c_int),
+        ('start_time', ctypes.c_int),
+        ('ct', ctypes.c_int),
+        ('wt', ctypes.c_int),
+        ('tat', ctypes.c_int),
+        ('rt', ctypes.c_int),
+    ]
+
+
+class SchedulerParams(ctypes.Structure):
+    _fields_ = [
+        ('version', ctypes.c_int),
+        ('algorithm', ctypes.c_int),
+        ('time_quantum', ctypes.c_int),
+        ('mlfq_quantum', ctypes.c_int),
+        ('sched_latency', ctypes.c_int),
+        ('min_granularity', ctypes.c_int),
+        ('use_nice', ctypes.c_int),
+        ('seed', ctypes.c_uint64),
+        ('workers', ctypes.c_int),
+        ('steal_cost', ctypes.c_int),
+    ]
+
+
+class SchedulerGanttEvent(ctypes.Structure):
+    _fields_ = [('pid', ctypes.c_int), ('start', ctypes.c_int), ('end', ctypes.c_int)]
+
+
+class SchedulerVRuntimeSegment(ctypes.Structure):
+    _fields_ = [
+        ('pid', ctypes.c_int),
+        ('start', ctypes.c_int),
+        ('end', ctypes.c_int),
+        ('vruntime', ctypes.c_int64),
+        ('rate', ctypes.c_int64),
+    ]
+
+
+class SchedulerResult(ctypes.Structure):
+    _fields_ = [
+        ('avg_wt', ctypes.c_double),
+        ('avg_tat', ctypes.c_double),
+        ('avg_rt', ctypes.c_double),
+        ('p99_rt', ctypes.c_double),
+        ('p99_tat', ctypes.c_double),
+        ('cpu_util', ctypes.c_double),
+        ('effective_cpu_util', ctypes.c_double),
+        ('throughput', ctypes.c_double),
+        ('fairness', ctypes.c_double),
+        ('context_switches', ctypes.c_int64),
+        ('switch_overhead', ctypes.c_int64),
+        ('cache_overhead', ctypes.c_int64),
+        ('makespan', ctypes.c_int),
+        ('gantt', ctypes.POINTER(SchedulerGanttEvent)),
+        ('gantt_count', ctypes.c_int),
+        ('vruntime', ctypes.POINTER(SchedulerVRuntimeSegment)),
+        ('vruntime_count', ctypes.c_int),
+    ]
+
+
+def default_library_path(project_root):
+    """Where the CMake build puts the library on this platform."""
+    system = platform.system()
+    if system == 'Windows':
+        return os.path.join(project_root, 'build', 'Debug', 'scheduler.dll')
+    if system == 'Darwin':
+        return os.path.join(project_root, 'build', 'libscheduler.dylib')
+    return os.path.join(project_root, 'build', 'libscheduler.so')
+
+
+class Library:
+    """One loaded copy of libscheduler. Calls release the GIL, so threads
+    run simulations in parallel (the simulator keeps its state per thread)."""
+
+    def __init__(self, path):
+        self.path = path
+        self.lib = ctypes.CDLL(path)
+
+        self.lib.scheduler_api_version.restype = ctypes.c_int
+        self.lib.scheduler_api_version.argtypes = []
+        self.lib.scheduler_default_params.restype = None
+        self.lib.scheduler_default_params.argtypes = [ctypes.POINTER(SchedulerParams), ctypes.c_int]
+        self.lib.scheduler_run.restype = ctypes.c_int
+        self.lib.scheduler_run.argtypes = [ctypes.POINTER(SchedulerTask), ctypes.c_int,
+                                           ctypes.POINTER(SchedulerParams),
+                                           ctypes.POINTER(SchedulerResult)]
+        self.lib.scheduler_set_costs.restype = None
+        self.lib.scheduler_set_costs.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_int]
+        self.lib.scheduler_release_thread.restype = None
+        self.lib.scheduler_release_thread.argtypes = []
+
+        version = self.lib.scheduler_api_version()
+        if version != SCHEDULER_API_VERSION:
+            raise OSError(f"{path} has API version {version}, expected {SCHEDULER_API_VERSION}")
+
+    def default_params(self, algorithm):
+        params = SchedulerParams()
+        self.lib.scheduler_default_params(ctypes.byref(params), algorithm)
+        return params
+
+    def run(self, tasks, params):
+        """Runs one simulation on a SchedulerTask array, which receives the
+        per-task results. The result's gantt and vruntime pointers are only
+        valid until the next run on this thread."""
+        result = SchedulerResult()
+        status = self.lib.scheduler_run(tasks, len(tasks), ctypes.byref(params), ctypes.byref(result))
+        if status != SCHEDULER_OK:
+            raise ValueError(f"scheduler_run failed: {ERRORS.get(status, status)}")
+        return result
+
+    def release_thread(self):
+        self.lib.scheduler_release_thread()
+
+
+def dashboard_tasks(algo_id, processes):
+    """SchedulerTask array for the dashboard's process list, with the same
+    field mapping build_simulation_input uses for the CLI."""
+    tasks = (SchedulerTask * len(processes))()
+    for t, p in zip(tasks, processes):
+        t.at = int(p['arrival'])
+        t.bt = int(p['burst'])
+        if algo_id in (2, 9, 10):
+            t.priority = int(p.get('priority', 0))
+        extra = int(p.get('extraParam', 0) or 0)
+        if algo_id == 6:
+            t.deadline = extra
+        elif algo_id == 8:
+            t.period = extra
+        elif algo_id == 7:
+            t.tickets = extra if extra > 0 else 1
+    return tasks
+
+
+def simulate_dashboard(library, algo_id, processes):
+    """Runs a dashboard request in-process; returns the same dictionary
+    parse_c_output builds from the CLI's text output."""
+    params = library.default_params(algo_id)
+    if algo_id == 4:
+        params.time_quantum = int(processes[0].get('extraParam', 2))
+    tasks = dashboard_tasks(algo_id, processes)
+
+    try:
+        r = library.run(tasks, params)
+        gantt = [{'pid': g.pid, 'start': g.start, 'end': g.end}
+                 for g in r.gantt[:r.gantt_count]]
+        vruntime = [{'pid': v.pid, 'start': v.start, 'end': v.end,
+                     'vruntime_start': round(v.vruntime / VRUNTIME_SCALE, 4),
+                     'rate': round(v.rate / VRUNTIME_SCALE, 4),
+                     'vruntime_end': round((v.vruntime + (v.end - v.start) * v.rate) / VRUNTIME_SCALE, 4)}
+                    for v in r.vruntime[:r.vruntime_count]]
+    finally:
+        # Request threads come and go; keep no per-thread buffers behind
+        library.release_thread()
+
+    # Table order and number formats as printed by print_table
+    order = sorted(range(len(tasks)), key=lambda i: tasks[i].at) if algo_id == 1 else range(len(tasks))
+    results = [{'pid': str(i + 1), 'at': str(tasks[i].at), 'bt': str(tasks[i].bt),
+                'wt': str(tasks[i].wt), 'tat': str(tasks[i].tat), 'rt': str(tasks[i].rt)}
+               for i in order]
+    overhead = r.switch_overhead + r.cache_overhead
+    averages = {
+        'avg_wt': f"{r.avg_wt:.2f}",
+        'avg_tat': f"{r.avg_tat:.2f}",
+        'avg_rt': f"{r.avg_rt:.2f}",
+        'cpu_util': f"{r.cpu_util:.2f}%",
+        'effective_cpu_util': f"{r.effective_cpu_util:.2f}%",
+        'context_switches': str(r.context_switches),
+        'switch_overhead': f"{overhead} (switch {r.switch_overhead} + cache {r.cache_overhead})",
+        'throughput': f"{r.throughput:.2f} processes/unit time",
+        'fairness_index': f"{r.fairness:.4f}",
+    }
+    return {'processes': results, 'averages': averages, 'gantt': gantt, 'vruntime': vruntime}
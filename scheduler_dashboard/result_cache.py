@@ -0,0 +1,133 @@
+import os
+import json
+import hashlib
+import threading
+from collections import OrderedDict
+
+
+def cache_key(executable, args, input_str):
+    """Canonical SHA-256 of everything that determines a simulation result.
+
+    The workload is hashed in the exact form the C program reads it (the
+    scanf-shaped stdin), so two requests that only differ in JSON key order
+    or unused fields share an entry. The executable's size and mtime are
+    included so a rebuilt binary never serves stale results.
+    """
+    try:
+        st = os.stat(executable)
+        binary = [st.st_size, st.st_mtime_ns]
+    except OSError:
+        binary = None
+
+    canonical = json.dumps({
+        'binary': binary,
+        'args': [str(a) for a in args],
+        'input': input_str,
+    }, sort_keys=True, separators=(',', ':'))
+    return hashlib.sha256(canonical.encode('utf-8')).hexdigest()
+
+
+class ResultCache:
+    """Memory-bounded LRU of parsed results with an optional on-disk tier.
+
+    Entries are charged by the size of their JSON encoding. When the
+    in-memory tier exceeds max_bytes the least recently used entries are
+    evicted; if a disk directory is configured every entry is also written
+    there and misses fall back to it before re-running the simulation.
+    """
+
+    def __init__(self, max_bytes=64 * 1024 * 1024, disk_dir=None):
+        self.max_bytes = max_bytes
+        self.disk_dir = disk_dir
+        self._entries = OrderedDict()   # key -> (value, size)
+        self._bytes = 0
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.disk_hits = 0
+        self.misses = 0
+
+        if self.disk_dir:
+            os.makedirs(self.disk_dir, exist_ok=True)
+
+    # --- Lookup ---
+    def get(self, key):
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is not None:
+                self._entries.move_to_end(key)
+                self.hits += 1
+                return entry[0]
+
+        value = self._disk_read(key)
+        if value is not None:
+            with self._lock:
+                self.disk_hits += 1
+            self._remember(key, value, json.dumps(value, separators=(',', ':')))
+            return value
+
+        with self._lock:
+            self.misses += 1
+        return None
+
+    # --- Insertion ---
+    def put(self, key, value):
+        encoded = json.dumps(value, separators=(',', ':'))
+        self._remember(key, value, encoded)
+        self._disk_write(key, encoded)
+
+    def _remember(self, key, value, encoded):
+        size = len(encoded)
+        if size > self.max_bytes:
+            return  # Would evict everything else; leave it to the disk tier
+
+        with self._lock:
+            old = self._entries.pop(key, None)
+            if old is not None:
+                self._bytes -= old[1]
+            self._entries[key] = (value, size)
+            self._bytes += size
+
+            # Evict least recently used entries until we fit again
+            while self._bytes > self.max_bytes:
+                _, (_, evicted_size) = self._entries.popitem(last=False)
+                self._bytes -= evicted_size
+
+    # --- Disk Tier ---
+    def _disk_path(self, key):
+        # Two-level fan-out keeps directories small
+        return os.path.join(self.disk_dir, key[:2], f"{key}.json")
+
+    def _disk_read(self, key):
+        if not self.disk_dir:
+            return None
+        try:
+            with open(self._disk_path(key), 'r', encoding='utf-8') as fp:
+                return json.load(fp)
+        except (OSError, ValueError):
+            return None
+
+    def _disk_write(self, key, encoded):
+        if not self.disk_dir:
+            return
+        path = self._disk_path(key)
+        try:
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            # Write then rename so readers never see a partial file
+            tmp = f"{path}.{os.getpid()}.{threading.get_ident()}.tmp"
+            with open(tmp, 'w', encoding='utf-8') as fp:
+                fp.write(encoded)
+            os.replace(tmp, path)
+        except OSError:
+            pass  # The disk tier is best-effort
+
+    def stats(self):
+        with self._lock:
+            return {
+                'entries': len(self._entries),
+                'bytes': self._bytes,
+                'max_bytes': self.max_bytes,
+                'hits': self.hits,
+                'disk_hits': self.disk_hits,
+                'misses': self.misses,
+                'disk_dir': self.disk_dir,
+            }
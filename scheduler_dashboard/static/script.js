@@ -3,10 +3,11 @@ document.addEventListener('DOMContentLoaded', () => {
     let pidCounter = 1;
 
     // --- Metrics Storage for Comparison ---
-    const ALGO_ORDER = ['cfs', 'edf', 'fcfs', 'mlfq', 'priority', 'propshare', 'rms', 'rr', 'sjf'];
+    const ALGO_ORDER = ['cfs', 'edf', 'eevdf', 'fcfs', 'mlfq', 'priority', 'propshare', 'rms', 'rr', 'sjf'];
     const ALGO_COLORS = {
         'cfs': '#ef4444',       // Red
         'edf': '#f97316',       // Orange
+        'eevdf': '#ec4899',     // Pink
         'fcfs': '#f59e0b',      // Amber
         'mlfq': '#84cc16',      // Lime
         'priority': '#22c55e',  // Green
@@ -57,6 +58,11 @@ document.addEventListener('DOMContentLoaded', () => {
             desc: `<p>The Completely Fair Scheduler (CFS) models an "ideal, precise multi-tasking CPU". It tracks <i>virtual runtime</i> (vruntime) via a red-black tree. The task with the lowest vruntime is picked next. Priorities are mapped to weights: higher weight (lower nice value) slows down vruntime growth, granting more CPU time.</p>`,
             formula: `<strong>vruntime += &Delta;exec &times; (W<sub>base</sub> / W<sub>i</sub>)</strong>`
         },
+        'eevdf': {
+            title: 'Earliest Eligible Virtual Deadline First (EEVDF)',
+            desc: `<p>EEVDF replaced the CFS pick-next logic in Linux 6.6. Every task tracks its <i>lag</i>: the service it is owed relative to the weighted average vruntime V. Only tasks with non-negative lag are <b>eligible</b>, and among them the one with the earliest <b>virtual deadline</b> runs. An augmented tree caches the minimum deadline per subtree, so picking stays O(log n).</p>`,
+            formula: `<strong>eligible: v<sub>i</sub> &le; V &nbsp;&nbsp; vd<sub>i</sub> = v<sub>i</sub> + r &times; (W<sub>base</sub> / W<sub>i</sub>)</strong>`
+        },
         'edf': {
             title: 'Earliest Deadline First (EDF)',
             desc: `<p>EDF is a dynamic priority real-time algorithm. It prioritizes tasks with the closest <b>Absolute Deadline</b>. If a new task arrives with a sooner deadline than the current one, preemption occurs.</p>`,
@@ -158,7 +164,7 @@ document.addEventListener('DOMContentLoaded', () => {
 
         // --- NEW LOGIC: Set default value based on algorithm ---
         const prioInput = row.querySelector('.input-priority');
-        const needsPriority = ['priority', 'cfs'].includes(currentAlgo);
+        const needsPriority = ['priority', 'cfs', 'eevdf'].includes(currentAlgo);
         const prioWrapper = prioInput.closest('.input-wrapper');
 
         if (needsPriority) prioWrapper.classList.remove('hidden');
@@ -234,7 +240,7 @@ document.addEventListener('DOMContentLoaded', () => {
         extraWrappers.forEach(toggleExtraField);
 
         // 4. Handle Priority Field Visibility
-        const needsPriority = ['priority', 'cfs'].includes(algoName);
+        const needsPriority = ['priority', 'cfs', 'eevdf'].includes(algoName);
         togglePriorityField(needsPriority);
 
         // 5. Handle Global Settings (TQ for RR)
@@ -368,7 +374,7 @@ document.addEventListener('DOMContentLoaded', () => {
 
         // Render VRuntime Chart (CFS only)
         const vruntimeCard = document.getElementById('vruntime-card');
-        if (data.vruntime && data.vruntime.length > 0 && currentAlgo === 'cfs') {
+        if (data.vruntime && data.vruntime.length > 0 && ['cfs', 'eevdf'].includes(currentAlgo)) {
             vruntimeCard.classList.remove('hidden');
             renderVRuntimeChart(data.vruntime);
         } else {
@@ -433,6 +439,25 @@ document.addEventListener('DOMContentLoaded', () => {
     }
 
     // --- VRuntime Chart (CFS Signature) ---
+    // The simulator logs one segment per run of a task, in start order:
+    // vruntime grows by 'rate' per tick from vruntime_start at 'start' to
+    // vruntime_end at 'end'. Points per PID are each segment's two ends; the
+    // straight line between them is exact, so no per-tick points are needed
+    function groupVRuntimeByPid(vruntimeData) {
+        const pidData = {};
+        vruntimeData.forEach(segment => {
+            if (!pidData[segment.pid]) {
+                pidData[segment.pid] = [];
+            }
+            pidData[segment.pid].push({ x: segment.start, y: segment.vruntime_start });
+            if (segment.end > segment.start) {
+                pidData[segment.pid].push({ x: segment.end, y: segment.vruntime_end });
+            }
+        });
+        Object.values(pidData).forEach(points => points.sort((a, b) => a.x - b.x));
+        return pidData;
+    }
+
     function renderVRuntimeChart(vruntimeData) {
         if (!vruntimeData || vruntimeData.length === 0) return;
 
@@ -443,14 +468,7 @@ document.addEventListener('DOMContentLoaded', () => {
             charts['chart-vruntime'].destroy();
         }
 
-        // Group data by PID
-        const pidData = {};
-        vruntimeData.forEach(entry => {
-            if (!pidData[entry.pid]) {
-                pidData[entry.pid] = [];
-            }
-            pidData[entry.pid].push({ x: entry.time, y: entry.vruntime });
-        });
+        const pidData = groupVRuntimeByPid(vruntimeData);
 
         // Create datasets for each process
         const colors = ['#6366f1', '#ec4899', '#14b8a6', '#f59e0b', '#8b5cf6', '#ef4444', '#22c55e', '#06b6d4', '#f97316'];
@@ -460,7 +478,7 @@ document.addEventListener('DOMContentLoaded', () => {
             borderColor: colors[index % colors.length],
             backgroundColor: colors[index % colors.length] + '20',
             fill: false,
-            tension: 0.1,
+            tension: 0,
             pointRadius: 2,
             borderWidth: 2
         }));
@@ -573,6 +591,69 @@ document.addEventListener('DOMContentLoaded', () => {
         }
     }
 
+    // --- Asynchronous Simulation Jobs ---
+    // Runs are submitted as jobs; progress and partial Gantt segments arrive
+    // over server-sent events until the final result (or an error) does.
+    let activeJob = null;
+
+    async function runSimulationJob(payload) {
+        // Only one run at a time: a new submission cancels the previous job
+        if (activeJob) {
+            activeJob.source.close();
+            fetch(`/api/jobs/${activeJob.id}`, { method: 'DELETE' });
+            activeJob.resolve(null);
+            activeJob = null;
+        }
+
+        const response = await fetch('/api/jobs', {
+            method: 'POST',
+            headers: { 'Content-Type': 'application/json' },
+            body: JSON.stringify(payload)
+        });
+        const submitted = await response.json();
+        if (!response.ok) throw new Error(submitted.error || 'Server error');
+
+        return new Promise((resolve, reject) => {
+            const source = new EventSource(`/api/jobs/${submitted.job_id}/events`);
+            const job = { id: submitted.job_id, source, resolve };
+            const partialGantt = [];
+            activeJob = job;
+
+            const finish = () => {
+                source.close();
+                if (activeJob === job) activeJob = null;
+            };
+
+            source.addEventListener('progress', (e) => {
+                const record = JSON.parse(e.data);
+                updateStatus('running', `Simulating... t=${record.time} (${record.completed}/${record.total})`);
+                if (record.gantt && record.gantt.length > 0) {
+                    partialGantt.push(...record.gantt);
+                    renderGanttChart(partialGantt);
+                }
+            });
+            source.addEventListener('done', (e) => {
+                finish();
+                resolve(JSON.parse(e.data));
+            });
+            source.addEventListener('failed', (e) => {
+                finish();
+                reject(new Error(JSON.parse(e.data).error || 'Simulation failed'));
+            });
+            source.addEventListener('cancelled', () => {
+                finish();
+                resolve(null);
+            });
+            source.onerror = () => {
+                // Stream closed by the server after a final event, or lost
+                if (source.readyState === EventSource.CLOSED && activeJob === job) {
+                    finish();
+                    reject(new Error('Lost connection to simulation job'));
+                }
+            };
+        });
+    }
+
     // --- Listeners ---
     menuItems.forEach(item => {
         if (!item.classList.contains('special-item')) {
@@ -590,13 +671,8 @@ document.addEventListener('DOMContentLoaded', () => {
         }
         updateStatus('running', 'Simulating...');
         try {
-            const response = await fetch('/api/simulate', {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify(payload)
-            });
-            const data = await response.json();
-            if (!response.ok) throw new Error(data.error || 'Server error');
+            const data = await runSimulationJob(payload);
+            if (data === null) return; // Superseded by a newer run
             renderResults(data);
         } catch (error) {
             console.error(error);
@@ -668,14 +744,7 @@ document.addEventListener('DOMContentLoaded', () => {
                     setTimeout(() => {
                         const ctx = document.getElementById('modal-chart-vruntime').getContext('2d');
 
-                        // Group data by PID
-                        const pidData = {};
-                        cachedData.vruntime.forEach(entry => {
-                            if (!pidData[entry.pid]) {
-                                pidData[entry.pid] = [];
-                            }
-                            pidData[entry.pid].push({ x: entry.time, y: entry.vruntime });
-                        });
+                        const pidData = groupVRuntimeByPid(cachedData.vruntime);
 
                         // Create datasets for each process
                         const colors = ['#6366f1', '#ec4899', '#14b8a6', '#f59e0b', '#8b5cf6', '#ef4444', '#22c55e', '#06b6d4', '#f97316'];
@@ -685,7 +754,7 @@ document.addEventListener('DOMContentLoaded', () => {
                             borderColor: colors[index % colors.length],
                             backgroundColor: colors[index % colors.length] + '20',
                             fill: false,
-                            tension: 0.1,
+                            tension: 0,
                             pointRadius: 3,
                             borderWidth: 3
                         }));
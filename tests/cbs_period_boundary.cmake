@@ -0,0 +1,39 @@
+# CBS regression: a reservation whose budget runs out exactly at its period
+# boundary (deadline == period, the default) is replenished on the spot and
+# must stay in the ready heap once, not twice.
+# Usage: cmake -DSCHEDULER=<path> -DINPUT_DIR=<dir> -P cbs_period_boundary.cmake
+
+# The CLI exports simulation_output.json to its parent directory: run one
+# level below the build tree so nothing lands in the sources
+set(run_dir ${CMAKE_CURRENT_BINARY_DIR}/cbs_period_boundary)
+file(MAKE_DIRECTORY ${run_dir})
+
+# Lone task, runtime 2 every 2 ticks: every period is met
+execute_process(
+    COMMAND ${SCHEDULER} 6 --cbs --rt-runtime -1
+    INPUT_FILE ${INPUT_DIR}/cbs_period_boundary.in
+    WORKING_DIRECTORY ${run_dir}
+    OUTPUT_VARIABLE out
+    RESULT_VARIABLE status
+    TIMEOUT 10)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "lone task run failed: ${status}")
+endif()
+if(NOT out MATCHES "Deadline Misses += 0\n")
+    message(FATAL_ERROR "lone task reported deadline misses:\n${out}")
+endif()
+
+# Two reservations with switch costs: used to grow the heap without bound
+execute_process(
+    COMMAND ${SCHEDULER} 6 --cbs --cs-cost 1
+    INPUT_FILE ${INPUT_DIR}/cbs_period_boundary_cs.in
+    WORKING_DIRECTORY ${run_dir}
+    OUTPUT_VARIABLE out
+    RESULT_VARIABLE status
+    TIMEOUT 10)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "two-task run did not finish: ${status}")
+endif()
+if(NOT out MATCHES "Rejected Tasks += 0")
+    message(FATAL_ERROR "two-task run incomplete:\n${out}")
+endif()